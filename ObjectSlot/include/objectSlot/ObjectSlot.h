@@ -4,4 +4,22 @@
 #include "detail/RefSlotSystem.h"
 #include "detail/SlotRef.h"
 #include "detail/SubscriptionRef.h"
-#include "detail/EnableSlotFromThis.h"
\ No newline at end of file
+#include "detail/EnableSlotFromThis.h"
+#include "detail/ReleaseAwaiter.h"
+#include "detail/PoolCommandBuffer.h"
+#include "detail/StaticSlotSystem.h"
+#include "detail/PoolGroup.h"
+#include "detail/VariantSlotSystem.h"
+#include "detail/SlotGraphSerializer.h"
+#include "detail/TransientSlotSystem.h"
+#include "detail/EnableSlotFromAddress.h"
+#include "detail/SlotOccupancyMap.h"
+#include "detail/LatencyHistogram.h"
+#include "detail/SlotTraceRecorder.h"
+#include "detail/SlotCycleVisitor.h"
+#include "detail/SlotCycleCollector.h"
+#include "detail/SlotFastExit.h"
+#include "detail/SlotReservationProfile.h"
+#include "detail/SlotMemoryBudget.h"
+#include "detail/MemoryPressureWatcher.h"
+#include "detail/SlotAllocationSampler.h"
\ No newline at end of file
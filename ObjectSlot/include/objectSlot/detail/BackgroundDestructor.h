@@ -0,0 +1,205 @@
+#pragma once
+
+#include <cassert>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief 要素の破棄をバックグラウンドスレッドで行うかどうかを指定する特性
+ *
+ * 破棄に時間のかかる型（大きなヒープバッファを持つメッシュ等）に対して特殊化し、
+ * std::true_typeを継承させると、参照カウントが0になった要素を
+ * スロットからムーブで取り出し、デストラクタをバックグラウンドスレッドで実行する。
+ *
+ * 使用例:
+ * @code
+ *   template<>
+ *   struct UseBackgroundDestruction<HeavyMesh> : std::true_type {};
+ * @endcode
+ *
+ * 対象の型はムーブ構築可能で、ムーブ後の抜け殻の破棄が軽量である必要がある。
+ * また、デストラクタが別スレッドから呼ばれても安全でなければならない。
+ * SlotPtrやSlotRefなどプールの参照を持つ型は対象にできない（参照カウントを別スレッドから操作してしまうため）。
+ * HoldsSlotReferencesを特殊化した型はコンパイル時に拒否し、それ以外もワーカースレッドから
+ * プールを書き換えようとした時点で（NDEBUGでも）異常終了する。
+ *
+ * @tparam T 対象の要素の型
+ */
+template<typename T>
+struct UseBackgroundDestruction : std::false_type {};
+
+/**
+ * @brief 要素がプールの参照（SlotPtr・SlotRef・SubscriptionRefなど）を持つことを示す特性
+ *
+ * std::true_typeを継承させた型は、UseBackgroundDestructionを有効にするとコンパイルエラーになる。
+ *
+ * 使用例:
+ * @code
+ *   template<>
+ *   struct HoldsSlotReferences<SceneNode> : std::true_type {};
+ * @endcode
+ *
+ * @tparam T 対象の要素の型
+ */
+template<typename T>
+struct HoldsSlotReferences : std::false_type {};
+
+// 前方宣言
+template<typename T>
+class BackgroundDestructor;
+
+/**
+ * @brief 現在のスレッドがBackgroundDestructorのワーカースレッドかどうか
+ *
+ * プールの参照カウント・SlotRefの登録・購読を書き換える入口から呼ばれ、
+ * ワーカースレッドで破棄された要素がプールの参照を解放していないかを検出する。
+ */
+class BackgroundDestructionThread {
+    template<typename T>
+    friend class BackgroundDestructor;
+
+public:
+    /// 現在のスレッドがワーカースレッドならtrue
+    static bool IsCurrent() { return s_current; }
+
+    /**
+     * @brief ワーカースレッドから呼ばれていたら異常終了する
+     *
+     * プールの状態を書き換える前に呼ぶ。NDEBUGでも無効にならない。
+     */
+    static void CheckNotCurrent() {
+        if (s_current) {
+            assert(!"バックグラウンドで破棄する要素がプールの参照を保持しています。");
+            std::abort();
+        }
+    }
+
+private:
+    /** ワーカースレッドでのみtrueになるフラグ */
+    static inline thread_local bool s_current = false;
+};
+
+/**
+ * @brief 要素のデストラクタをバックグラウンドスレッドで実行する
+ *
+ * 型ごとに1つのワーカースレッドを持ち、Enqueue()でムーブされた要素を
+ * まとめて破棄する。スレッドは最初のEnqueue()で起動し、
+ * インスタンスの破棄時に残りの要素を全て破棄してから終了する。
+ *
+ * ObjectSlotSystemBaseの削除処理から使われる。
+ * プールの操作自体はこれまで通りシングルスレッドが前提で、
+ * ワーカースレッドが触るのはプールから取り出された要素だけである。
+ *
+ * @tparam T 破棄する要素の型
+ */
+template<typename T>
+class BackgroundDestructor {
+public:
+    /// シングルトンインスタンスを取得
+    static BackgroundDestructor& GetInstance() {
+        static BackgroundDestructor instance;
+        return instance;
+    }
+
+    /**
+     * @brief 要素を破棄キューに追加する
+     *
+     * @param obj 破棄する要素（ムーブされる）
+     */
+    void Enqueue(T&& obj) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queue.push_back(std::move(obj));
+            if (!m_worker.joinable()) {
+                m_worker = std::thread([this]() { Run(); });
+            }
+        }
+        m_wake.notify_one();
+    }
+
+    /// キューに積まれた要素の破棄が全て完了するまで待つ
+    void Flush() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [this]() { return m_queue.empty() && m_inFlight == 0; });
+    }
+
+    /// 破棄待ちと破棄中の要素数を取得
+    size_t PendingCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_queue.size() + m_inFlight;
+    }
+
+    // コピー・ムーブ禁止
+    BackgroundDestructor(const BackgroundDestructor&) = delete;
+    BackgroundDestructor& operator=(const BackgroundDestructor&) = delete;
+    BackgroundDestructor(BackgroundDestructor&&) = delete;
+    BackgroundDestructor& operator=(BackgroundDestructor&&) = delete;
+
+private:
+    BackgroundDestructor() = default;
+
+    /// 残りの要素を破棄してからワーカースレッドを終了する
+    ~BackgroundDestructor() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_one();
+        if (m_worker.joinable()) {
+            m_worker.join();
+        }
+    }
+
+    /**
+     * @brief ワーカースレッドの処理
+     *
+     * キューをローカルのバッファと入れ替え、ロックを外してから破棄する。
+     * 破棄中も他のスレッドは次の要素を積める。
+     */
+    void Run() {
+        BackgroundDestructionThread::s_current = true;
+        std::vector<T> batch;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_wake.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+            if (m_queue.empty()) break;
+
+            batch.swap(m_queue);
+            m_inFlight = batch.size();
+            lock.unlock();
+
+            batch.clear();
+
+            lock.lock();
+            m_inFlight = 0;
+            if (m_queue.empty()) {
+                m_idle.notify_all();
+            }
+        }
+    }
+
+    /** キューと状態を保護するミューテックス */
+    mutable std::mutex m_mutex;
+
+    /** ワーカースレッドを起こす条件変数 */
+    std::condition_variable m_wake;
+
+    /** 破棄の完了を待つ側を起こす条件変数 */
+    std::condition_variable m_idle;
+
+    /** 破棄待ちの要素 */
+    std::vector<T> m_queue;
+
+    /** ワーカースレッドが破棄中の要素数 */
+    size_t m_inFlight = 0;
+
+    /** 終了要求フラグ */
+    bool m_stop = false;
+
+    /** 破棄を実行するワーカースレッド */
+    std::thread m_worker;
+};
\ No newline at end of file
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "ObjectSlotSystem.h"
+#include "SlotHandle.h"
+#include <cstdint>
+#include <utility>
+
+/**
+ * @brief メンバを持たないEnableSlotFromThis
+ *
+ * EnableSlotFromThisはハンドルとプールへのポインタ（16バイト）を各オブジェクトに持ち、
+ * 作成のたびにAllocateSlotで書き込む。
+ * EnableSlotFromAddressは何も保持せず、自分のアドレスと要素配列の先頭の差から
+ * スロットインデックスを求め、プールは型ごとのシングルトンから取得する。
+ * そのため基底クラスのサイズは0で（空基底の最適化）、作成時の初期化も不要になる。
+ * EnableSlotFromThisと同じく仮想関数を持たないので、Tがトリビアルな型ならトリビアルなまま保たれる。
+ *
+ * プールの指定はテンプレート引数で行う（既定はObjectSlotSystem）。
+ * SignalSlotSystem/RefSlotSystemを指定した場合はSignalSlotPtrを返す。
+ *
+ * 使用例:
+ * @code
+ *   class Node : public EnableSlotFromAddress<Node> {
+ *   public:
+ *       void Attach(Scene& scene) { scene.Add(SlotPtrFromThis()); }
+ *   };
+ *
+ *   class Device : public EnableSlotFromAddress<Device, SignalSlotSystem> { ... };
+ * @endcode
+ *
+ * 注意事項:
+ * - 指定したプールのシングルトンに格納されている場合のみ有効。
+ *   プールの外（スタック上のコピー等）から呼ぶと空のポインタを返す
+ * - インデックスは呼び出し時点の要素配列から求めるため、
+ *   フォールバック環境で再アロケーションが起きた後でも正しく求まる
+ *
+ * @tparam T 管理対象の型（CRTP: 自分自身の型を渡す）
+ * @tparam Pool 格納先のプールのクラステンプレート
+ */
+template<typename T, template<typename> class Pool = ObjectSlotSystem>
+class EnableSlotFromAddress {
+public:
+    /** FromThis()が返す強参照の型（プールのCreate()の戻り値と同じ） */
+    using Owner = decltype(std::declval<Pool<T>&>().Create(std::declval<T&&>()));
+
+protected:
+    EnableSlotFromAddress() = default;
+    ~EnableSlotFromAddress() = default;
+
+    /**
+     * @brief 自分自身への強参照を取得
+     *
+     * @return 自分自身を指すSlotPtr/SignalSlotPtr。プール外のオブジェクトなら空
+     */
+    Owner SlotPtrFromThis() const {
+        Pool<T>& pool = Pool<T>::GetInstance();
+        uint32_t index = IndexInPool(pool);
+        if (index == SlotHandle::INVALID_INDEX) return Owner();
+
+        pool.AddRefByIndex(index);
+        return Owner(pool.GetRootPointer(index), &pool);
+    }
+
+    /**
+     * @brief 自分自身への弱参照を取得
+     *
+     * @return 自分自身を指すWeakSlotPtr/WeakSignalSlotPtr。プール外のオブジェクトなら空
+     */
+    auto WeakSlotPtrFromThis() const {
+        // 一時的に強参照を作り、そこから弱参照に変換する（参照カウントは元に戻る）
+        return SlotPtrFromThis().GetWeak();
+    }
+
+    /// 自分自身のハンドルを取得（プール外のオブジェクトなら無効ハンドル）
+    SlotHandle SlotHandleFromThis() const {
+        Pool<T>& pool = Pool<T>::GetInstance();
+        uint32_t index = IndexInPool(pool);
+        if (index == SlotHandle::INVALID_INDEX) return SlotHandle::Invalid();
+        return pool.HandleFromIndex(index);
+    }
+
+private:
+    /**
+     * @brief 自分のアドレスからスロットインデックスを求める
+     *
+     * 要素配列の範囲内で、生存しているスロットの先頭を指す場合のみ有効なインデックスを返す。
+     * プール外のオブジェクトと配列のポインタ比較は未規定なので、アドレスを整数にして比較する。
+     */
+    uint32_t IndexInPool(Pool<T>& pool) const {
+        const T* begin = pool.DataPtr();
+        if (begin == nullptr) return SlotHandle::INVALID_INDEX;
+
+        const std::uintptr_t self = reinterpret_cast<std::uintptr_t>(static_cast<const T*>(this));
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(begin);
+        if (self < base) return SlotHandle::INVALID_INDEX;
+
+        const std::uintptr_t offset = self - base;
+        if (offset % sizeof(T) != 0 || offset / sizeof(T) >= pool.Capacity()) {
+            return SlotHandle::INVALID_INDEX;
+        }
+
+        uint32_t index = static_cast<uint32_t>(offset / sizeof(T));
+        if (!pool.IsValidHandle(pool.HandleFromIndex(index))) return SlotHandle::INVALID_INDEX;
+        return index;
+    }
+};
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "SlotHandle.h"
 #include "SlotControlBase.h"
+#include <type_traits>
 
 // 前方宣言（メソッド本体はテンプレートの遅延実体化で解決される）
 template<typename T> class ObjectSlotSystemBase;
@@ -43,6 +44,11 @@ template<typename T> class WeakSignalSlotPtr;
  * - 間違ったプール型に対応するメソッドを呼ぶと未定義動作になる
  * - コピー・ムーブ時にスロット情報は転送されない
  *   （std::enable_shared_from_thisと同じ動作）
+ * - 仮想関数を持たないため、継承しても各オブジェクトに仮想関数テーブルへのポインタは追加されない。
+ *   Tがトリビアルに破棄可能なら、継承後もトリビアルに破棄可能なまま保たれ、
+ *   プールの一括破棄（Clear等）はデストラクタのループを省略できる
+ * - デストラクタはprotectedで、基底クラスのポインタ経由では破棄できない
+ *   （プールは常に要素の型Tとして破棄する）
  *
  * @tparam T 管理対象の型（CRTP: 自分自身の型を渡す）
  */
@@ -101,9 +107,15 @@ public:
      */
     EnableSlotFromThis& operator=(EnableSlotFromThis&&) noexcept { return *this; }
 
-    virtual ~EnableSlotFromThis() = default;
-
 protected:
+    /**
+     * @brief デストラクタ（非仮想）
+     *
+     * protectedにすることで、基底クラスのポインタ経由のdeleteをコンパイルエラーにする。
+     * 非仮想のため、派生クラスのトリビアルな破棄を妨げない。
+     */
+    ~EnableSlotFromThis() = default;
+
     // ================================================================
     // 強参照の取得
     // ================================================================
@@ -232,6 +244,11 @@ private:
      */
     void InitSlotFromThis(SlotHandle handle, SlotControlBase* control)
     {
+        static_assert(!std::is_polymorphic_v<EnableSlotFromThis>,
+            "EnableSlotFromThisは仮想関数を持ってはいけません（要素に仮想関数テーブルへのポインタが追加されます）。");
+        static_assert(!std::is_destructible_v<EnableSlotFromThis>,
+            "EnableSlotFromThisは基底クラスのポインタ経由で破棄できてはいけません。");
+
         m_selfHandle = handle;
         m_selfControl = control;
     }
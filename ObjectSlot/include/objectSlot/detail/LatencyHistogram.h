@@ -0,0 +1,219 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief 対数バケットのヒストグラム（HDRヒストグラム形式の簡易版）
+ *
+ * 値を2のべき乗ごとのグループに分け、各グループをさらに16等分したバケットで数える。
+ * 相対誤差は最大で約6%に収まり、ナノ秒から数百年までの値を固定サイズ（約8KB）で保持できる。
+ * 記録は配列のインクリメントだけで、メモリ確保は行わない。
+ *
+ * 平均値では見えない裾（p99.9等）を調べるために使う。
+ * スレッドセーフではないため、プールと同じスレッドから記録・読み出しを行うこと。
+ */
+class LatencyHistogram {
+public:
+    /** 1グループを分割するビット数 */
+    static constexpr uint32_t SUB_BITS = 4;
+
+    /** 1グループのバケット数 */
+    static constexpr uint32_t SUB_COUNT = 1u << SUB_BITS;
+
+    /** 全バケット数 */
+    static constexpr size_t BUCKET_COUNT = (64 - SUB_BITS + 1) * SUB_COUNT;
+
+    /// 値を1つ記録する
+    void Record(uint64_t value) {
+        ++m_buckets[BucketIndex(value)];
+        ++m_count;
+        m_sum += value;
+        if (m_count == 1 || value < m_min) m_min = value;
+        if (value > m_max) m_max = value;
+    }
+
+    /// 別のヒストグラムの内容を加算する
+    void Merge(const LatencyHistogram& other) {
+        if (other.m_count == 0) return;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            m_buckets[i] += other.m_buckets[i];
+        }
+        if (m_count == 0 || other.m_min < m_min) m_min = other.m_min;
+        if (other.m_max > m_max) m_max = other.m_max;
+        m_count += other.m_count;
+        m_sum += other.m_sum;
+    }
+
+    /// 記録を全て消去する
+    void Reset() {
+        m_buckets.fill(0);
+        m_count = 0;
+        m_sum = 0;
+        m_min = 0;
+        m_max = 0;
+    }
+
+    /// 記録した値の数
+    uint64_t Count() const { return m_count; }
+
+    /// 最小値（記録がなければ0）
+    uint64_t Min() const { return m_min; }
+
+    /// 最大値（記録がなければ0）
+    uint64_t Max() const { return m_max; }
+
+    /// 平均値（記録がなければ0）
+    double Mean() const {
+        return m_count == 0 ? 0.0 : static_cast<double>(m_sum) / static_cast<double>(m_count);
+    }
+
+    /**
+     * @brief パーセンタイル値を取得
+     *
+     * 該当するバケットの上限を返す（最大値を超えない）。
+     *
+     * @param percentile 0〜100の値（99.9など）
+     * @return パーセンタイル値（記録がなければ0）
+     */
+    uint64_t Percentile(double percentile) const {
+        if (m_count == 0) return 0;
+        if (percentile <= 0.0) return m_min;
+
+        double target = percentile / 100.0 * static_cast<double>(m_count);
+        uint64_t rank = static_cast<uint64_t>(target);
+        if (static_cast<double>(rank) < target) ++rank;
+        if (rank > m_count) rank = m_count;
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += m_buckets[i];
+            if (seen >= rank) {
+                uint64_t upper = BucketUpper(i);
+                return upper < m_max ? upper : m_max;
+            }
+        }
+        return m_max;
+    }
+
+    /// 指定バケットの記録数を取得
+    uint64_t BucketCount(size_t index) const { return m_buckets[index]; }
+
+    /// 指定バケットに入る値の下限
+    static uint64_t BucketLower(size_t index) {
+        if (index < SUB_COUNT) return index;
+        const uint32_t shift = static_cast<uint32_t>(index / SUB_COUNT) - 1;
+        return (static_cast<uint64_t>(SUB_COUNT + index % SUB_COUNT)) << shift;
+    }
+
+    /// 指定バケットに入る値の上限
+    static uint64_t BucketUpper(size_t index) {
+        if (index < SUB_COUNT) return index;
+        const uint32_t shift = static_cast<uint32_t>(index / SUB_COUNT) - 1;
+        return BucketLower(index) + ((uint64_t(1) << shift) - 1);
+    }
+
+    /// 値が入るバケットのインデックス
+    static size_t BucketIndex(uint64_t value) {
+        if (value < SUB_COUNT) return static_cast<size_t>(value);
+        const uint32_t msb = HighestBit(value);
+        const uint32_t shift = msb - SUB_BITS;
+        const uint64_t sub = (value >> shift) & (SUB_COUNT - 1);
+        return static_cast<size_t>(shift + 1) * SUB_COUNT + static_cast<size_t>(sub);
+    }
+
+    /**
+     * @brief 要約を1行で書き出す
+     *
+     * 例: "create: count=1000 min=80 mean=120.5 p50=111 p90=143 p99=319 p99.9=1023 max=2210"
+     */
+    void DumpSummary(std::ostream& out, const char* name) const {
+        out << name << ": count=" << m_count
+            << " min=" << m_min
+            << " mean=" << Mean()
+            << " p50=" << Percentile(50.0)
+            << " p90=" << Percentile(90.0)
+            << " p99=" << Percentile(99.0)
+            << " p99.9=" << Percentile(99.9)
+            << " max=" << m_max << '\n';
+    }
+
+    /// 要約と、記録のあるバケットの一覧を書き出す
+    void Dump(std::ostream& out, const char* name) const {
+        DumpSummary(out, name);
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            if (m_buckets[i] != 0) {
+                out << "  [" << BucketLower(i) << ", " << BucketUpper(i) << "] " << m_buckets[i] << '\n';
+            }
+        }
+    }
+
+private:
+    /// 最上位の1ビットの位置（valueは0以外）
+    static uint32_t HighestBit(uint64_t value) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return static_cast<uint32_t>(index);
+#else
+        return 63u - static_cast<uint32_t>(__builtin_clzll(value));
+#endif
+    }
+
+    /** 各バケットの記録数 */
+    std::array<uint64_t, BUCKET_COUNT> m_buckets{};
+
+    /** 記録した値の数 */
+    uint64_t m_count = 0;
+
+    /** 記録した値の合計 */
+    uint64_t m_sum = 0;
+
+    /** 最小値 */
+    uint64_t m_min = 0;
+
+    /** 最大値 */
+    uint64_t m_max = 0;
+};
+
+/**
+ * @brief プール内部の処理時間の統計
+ *
+ * ObjectSlotSystemBase::SetLatencyTracking(true)で有効になる。
+ * 時間はナノ秒単位。
+ */
+struct SlotLatencyStats {
+    /** AllocateSlotの処理時間 */
+    LatencyHistogram create;
+
+    /** 要素1つの削除処理時間（デストラクタを含む。連鎖した同じプールの解放は遅延削除として別に数える） */
+    LatencyHistogram release;
+
+    /** 購読者への通知（コールバックの実行）にかかった時間 */
+    LatencyHistogram notify;
+
+    /** 最外の削除処理の後にまとめて実行した遅延削除の件数 */
+    LatencyHistogram removalBatch;
+
+    /// 全ての記録を消去する
+    void Reset() {
+        create.Reset();
+        release.Reset();
+        notify.Reset();
+        removalBatch.Reset();
+    }
+
+    /// 全ての統計の要約を書き出す
+    void Dump(std::ostream& out) const {
+        create.DumpSummary(out, "create_ns");
+        release.DumpSummary(out, "release_ns");
+        notify.DumpSummary(out, "notify_ns");
+        removalBatch.DumpSummary(out, "removal_batch");
+    }
+};
\ No newline at end of file
@@ -0,0 +1,275 @@
+#pragma once
+
+#include "SlotControlBase.h"
+#include "SlotPoolRegistry.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 読み取ったメモリ逼迫の状態
+ */
+struct MemoryPressureEvent {
+    /** PSI形式のファイルから読み取った場合はtrue、cgroupのイベント数の場合はfalse */
+    bool psi = false;
+
+    /** PSI: 一部のタスクがメモリ待ちで停止していた時間の割合（直近10秒、%） */
+    double someAvg10 = 0.0;
+
+    /** PSI: 全てのタスクがメモリ待ちで停止していた時間の割合（直近10秒、%） */
+    double fullAvg10 = 0.0;
+
+    /** PSI: 一部のタスクが停止していた累計時間（マイクロ秒） */
+    uint64_t someTotalUs = 0;
+
+    /** cgroup: memory.highを超えて回収が強制された回数の前回からの増分 */
+    uint64_t highDelta = 0;
+
+    /** cgroup: memory.maxに達した回数の前回からの増分 */
+    uint64_t maxDelta = 0;
+
+    /** cgroup: OOM（oom と oom_kill）の前回からの増分 */
+    uint64_t oomDelta = 0;
+
+    /** 今回の応答でプールから返却したバイト数（プールの返却前のアクションでは0） */
+    size_t releasedBytes = 0;
+};
+
+/**
+ * @brief メモリ逼迫を検出して、キャッシュの破棄やプールの縮小を行う監視役
+ *
+ * LinuxのPSI（/proc/pressure/memory、cgroup v2の memory.pressure）または
+ * cgroup v2の memory.events を読み、逼迫が強まっていればアクションを実行する。
+ * OOM killerが動く前に、プールが抱えている未使用のメモリを手放すために使う。
+ *
+ * 逼迫の判定:
+ * - PSI形式: "some" の avg10 がしきい値以上で、累計の停止時間（total）が前回から増えている
+ *   （初回はavg10だけで判定する）
+ * - memory.events形式: high / max / oom / oom_kill のいずれかが前回から増えている
+ *   （初回は基準値を記録するだけ）
+ *
+ * 逼迫時はAddAction()で登録した関数（キャッシュの破棄、古い要素の解放など）を登録順に実行した後、
+ * 有効ならSlotPoolRegistryの全プールのReleaseUnusedMemory()（ShrinkToFitと内側の空きページの破棄）を呼ぶ。
+ *
+ * ファイルの形式は内容から自動で判定するため、テストでは手元のファイルを指定できる。
+ * ファイルがない環境（Linux以外など）では何もしない。
+ *
+ * プールを操作するため、Poll()はプールを操作するスレッドから定期的に（フレームごと等）呼ぶこと。
+ *
+ * 使用例:
+ * @code
+ *   MemoryPressureWatcher watcher("/sys/fs/cgroup/memory.events");
+ *   watcher.AddAction([](const MemoryPressureEvent&) { textureCache.Trim(); });
+ *   while (running) {
+ *       watcher.Poll();
+ *       // ...
+ *   }
+ * @endcode
+ */
+class MemoryPressureWatcher {
+public:
+    /// 逼迫時に実行する関数
+    using Action = std::function<void(const MemoryPressureEvent&)>;
+
+    /** 既定の監視対象（システム全体のPSI） */
+    static constexpr const char* DEFAULT_SOURCE = "/proc/pressure/memory";
+
+    /**
+     * @param source 監視するファイル（PSI形式またはmemory.events形式）
+     * @param someAvg10Threshold PSI形式で逼迫とみなす "some" の avg10（%）
+     */
+    explicit MemoryPressureWatcher(std::string source = DEFAULT_SOURCE, double someAvg10Threshold = 10.0)
+        : m_source(std::move(source))
+        , m_someAvg10Threshold(someAvg10Threshold)
+    {}
+
+    /// 監視するファイルを変更する（前回の値は破棄する）
+    void SetSource(std::string source) {
+        m_source = std::move(source);
+        m_hasPrevious = false;
+    }
+
+    /// 監視しているファイル
+    const std::string& GetSource() const { return m_source; }
+
+    /// PSI形式で逼迫とみなす "some" の avg10（%）を設定する
+    void SetSomeAvg10Threshold(double percent) { m_someAvg10Threshold = percent; }
+
+    /// 逼迫時に全プールのReleaseUnusedMemory()を呼ぶかどうか（既定はtrue）
+    void SetReleasePools(bool enabled) { m_releasePools = enabled; }
+
+    /**
+     * @brief 逼迫時に実行する関数を登録する
+     *
+     * @return 登録を解除するためのID
+     */
+    uint32_t AddAction(Action action) {
+        const uint32_t id = m_nextActionId++;
+        m_actions.push_back({ id, std::move(action) });
+        return id;
+    }
+
+    /// 登録した関数を解除する
+    void RemoveAction(uint32_t id) {
+        for (auto it = m_actions.begin(); it != m_actions.end(); ++it) {
+            if (it->first == id) {
+                m_actions.erase(it);
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief 監視するファイルを読み、逼迫していればアクションとプールの縮小を実行する
+     *
+     * @return 逼迫を検出して応答した場合はtrue
+     */
+    bool Poll() {
+        MemoryPressureEvent event;
+        if (!ReadSource(event)) return false;
+        if (!IsPressured(event)) return false;
+
+        ++m_responseCount;
+        for (size_t i = 0; i < m_actions.size(); ++i) {
+            m_actions[i].second(event);
+        }
+        if (m_releasePools) {
+            SlotPoolRegistry::GetInstance().ForEachPool([&event](SlotControlBase& pool) {
+                event.releasedBytes += pool.ReleaseUnusedMemory();
+            });
+        }
+        m_lastReleasedBytes = event.releasedBytes;
+        return true;
+    }
+
+    /// これまでに逼迫を検出して応答した回数
+    uint64_t ResponseCount() const { return m_responseCount; }
+
+    /// 直近の応答でプールから返却したバイト数
+    size_t LastReleasedBytes() const { return m_lastReleasedBytes; }
+
+private:
+    /// ファイルを読んでeventを埋め、前回の値を更新する（読めなければfalse）
+    bool ReadSource(MemoryPressureEvent& event) {
+        std::ifstream in(m_source);
+        if (!in) return false;
+
+        uint64_t high = 0;
+        uint64_t max = 0;
+        uint64_t oom = 0;
+        bool parsed = false;
+
+        std::string line;
+        while (std::getline(in, line)) {
+            std::istringstream fields(line);
+            std::string key;
+            if (!(fields >> key)) continue;
+
+            if (key == "some" || key == "full") {
+                // PSI形式: "some avg10=1.23 avg60=0.50 avg300=0.10 total=123456"
+                event.psi = true;
+                parsed = true;
+                std::string field;
+                while (fields >> field) {
+                    const size_t eq = field.find('=');
+                    if (eq == std::string::npos) continue;
+                    const std::string name = field.substr(0, eq);
+                    const char* value = field.c_str() + eq + 1;
+                    if (name == "avg10") {
+                        (key == "some" ? event.someAvg10 : event.fullAvg10) = std::strtod(value, nullptr);
+                    }
+                    else if (name == "total" && key == "some") {
+                        event.someTotalUs = std::strtoull(value, nullptr, 10);
+                    }
+                }
+            }
+            else {
+                // memory.events形式: "high 12"
+                uint64_t value = 0;
+                if (!(fields >> value)) continue;
+                parsed = true;
+                if (key == "high") high = value;
+                else if (key == "max") max = value;
+                else if (key == "oom" || key == "oom_kill") oom += value;
+            }
+        }
+        if (!parsed) return false;
+
+        const bool first = !m_hasPrevious || m_previousPsi != event.psi;
+        if (!event.psi && !first) {
+            event.highDelta = high > m_previousHigh ? high - m_previousHigh : 0;
+            event.maxDelta = max > m_previousMax ? max - m_previousMax : 0;
+            event.oomDelta = oom > m_previousOom ? oom - m_previousOom : 0;
+        }
+        m_stallGrew = event.psi && (first || event.someTotalUs > m_previousTotalUs);
+        m_firstRead = first;
+
+        m_hasPrevious = true;
+        m_previousPsi = event.psi;
+        m_previousTotalUs = event.someTotalUs;
+        m_previousHigh = high;
+        m_previousMax = max;
+        m_previousOom = oom;
+        return true;
+    }
+
+    /// 読み取った値が逼迫を示しているか
+    bool IsPressured(const MemoryPressureEvent& event) const {
+        if (event.psi) {
+            return m_stallGrew && event.someAvg10 >= m_someAvg10Threshold;
+        }
+        if (m_firstRead) return false;
+        return event.highDelta > 0 || event.maxDelta > 0 || event.oomDelta > 0;
+    }
+
+    /** 監視するファイル */
+    std::string m_source;
+
+    /** PSI形式で逼迫とみなす "some" の avg10（%） */
+    double m_someAvg10Threshold;
+
+    /** 逼迫時に全プールのReleaseUnusedMemory()を呼ぶかどうか */
+    bool m_releasePools = true;
+
+    /** 逼迫時に実行する関数（ID, 関数） */
+    std::vector<std::pair<uint32_t, Action>> m_actions;
+
+    /** 次に発行するアクションのID */
+    uint32_t m_nextActionId = 0;
+
+    /** 応答した回数 */
+    uint64_t m_responseCount = 0;
+
+    /** 直近の応答でプールから返却したバイト数 */
+    size_t m_lastReleasedBytes = 0;
+
+    /** 前回の値を読み取り済みかどうか */
+    bool m_hasPrevious = false;
+
+    /** 前回の読み取りがPSI形式だったかどうか */
+    bool m_previousPsi = false;
+
+    /** 今回の読み取りが基準値の記録だったかどうか */
+    bool m_firstRead = false;
+
+    /** 今回の読み取りで停止時間が増えていたかどうか（PSI形式） */
+    bool m_stallGrew = false;
+
+    /** 前回の停止時間の累計（マイクロ秒、PSI形式） */
+    uint64_t m_previousTotalUs = 0;
+
+    /** 前回のhighの回数（memory.events形式） */
+    uint64_t m_previousHigh = 0;
+
+    /** 前回のmaxの回数（memory.events形式） */
+    uint64_t m_previousMax = 0;
+
+    /** 前回のoomとoom_killの回数の合計（memory.events形式） */
+    uint64_t m_previousOom = 0;
+};
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "ObjectSlotSystemBase.h"
 #include "SlotPtr.h"
 #include "WeakSlotPtr.h"
+#include "UniqueSlotPtr.h"
 
 /**
  * @brief シングルトンパターンのオブジェクトプール
@@ -33,17 +34,62 @@ public:
      * 通知機能なしのSlotPtrを返す。
      *
      * @param obj 追加する要素 (ムーブされる)
+     * @param site 呼び出し元の位置（作成位置のサンプリング用、通常は省略する）
      * @return 作成された要素へのSlotPtr
      */
-    SlotPtr<T> Create(T&& obj) {
-        if (!this->CanCreate()) return SlotPtr<T>();
+    SlotPtr<T> Create(T&& obj, SlotCallSite site = SlotCallSite::Current()) {
+        if (!this->PrepareCreate()) return SlotPtr<T>();
         
         SlotHandle handle = this->AllocateSlot(std::move(obj));
+        this->SampleAllocation(handle.index, site);
         ++this->m_refCounts[handle.index];
         auto rp = this->GetRootPointer(handle.index);
         return SlotPtr<T>(rp, this);
     }
 
+    /**
+     * @brief 新しい要素を作成（所有者が1つだけの場合）
+     *
+     * 参照カウントを操作しないUniqueSlotPtrを返す。
+     * 共有が必要になったらSlotPtrへムーブで変換できる。
+     *
+     * @param obj 追加する要素 (ムーブされる)
+     * @param site 呼び出し元の位置（作成位置のサンプリング用、通常は省略する）
+     * @return 作成された要素へのUniqueSlotPtr
+     */
+    UniqueSlotPtr<T> CreateUnique(T&& obj, SlotCallSite site = SlotCallSite::Current()) {
+        if (!this->PrepareCreate()) return UniqueSlotPtr<T>();
+
+        SlotHandle handle = this->AllocateSlot(std::move(obj));
+        this->SampleAllocation(handle.index, site);
+        this->m_refCounts[handle.index] = 1;
+        return UniqueSlotPtr<T>(this->GetRootPointer(handle.index));
+    }
+
+    /**
+     * @brief WriteCheckpoint()で書き出したチェックポイント列を再生してプールを復元
+     *
+     * 全体ブロックと差分ブロックを先頭から順に適用し、最終状態を
+     * 元と同じインデックス・世代番号で再構築する。
+     * 保存しておいたSlotHandleは復元後もそのまま使える。
+     *
+     * @param in 読み込み元のストリーム（バイナリモード）
+     * @return 復元された要素のSlotPtr（インデックス順）。
+     *         プールに有効な要素がある場合やデータが不正な場合は空を返し、プールは変更しない
+     */
+    std::vector<SlotPtr<T>> LoadCheckpointChain(std::istream& in) {
+        std::vector<SlotPtr<T>> result;
+        std::vector<uint32_t> restored;
+        if (!this->RestoreCheckpointChain(in, restored)) return result;
+
+        result.reserve(restored.size());
+        for (uint32_t index : restored) {
+            ++this->m_refCounts[index];
+            result.push_back(SlotPtr<T>(this->GetRootPointer(index), this));
+        }
+        return result;
+    }
+
     // コピー禁止
     ObjectSlotSystem(const ObjectSlotSystem&) = delete;
     ObjectSlotSystem& operator=(const ObjectSlotSystem&) = delete;
@@ -2,8 +2,25 @@
 
 #include "SlotControlBase.h"
 #include "EnableSlotFromThis.h"
+#include "BackgroundDestructor.h"
+#include "LatencyHistogram.h"
+#include "SlotTraceRecorder.h"
+#include "SlotCycleVisitor.h"
+#include "SlotFastExit.h"
+#include "SlotReservationProfile.h"
+#include "SlotAllocationSampler.h"
 #include "thirdparty/rootVector/RootVector.h"
 #include <type_traits>
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <typeinfo>
 
 // 前方宣言
 template<typename T>
@@ -12,6 +29,9 @@ class SlotPtr;
 template<typename T>
 class WeakSlotPtr;
 
+template<typename T>
+class UniqueSlotPtr;
+
 /**
  * @brief オブジェクトプールの基底クラス（軽量版）
  *
@@ -25,9 +45,35 @@ template<typename T>
 class ObjectSlotSystemBase : public SlotControlBase {
     friend class SlotPtr<T>;
     friend class WeakSlotPtr<T>;
+    friend class UniqueSlotPtr<T>;
 
 public:
-    virtual ~ObjectSlotSystemBase() = default;
+    ObjectSlotSystemBase() {
+        // 破棄スレッドをプールより先に生成し、プールより後に破棄されるようにする
+        if constexpr (UseBackgroundDestruction<T>::value) {
+            static_assert(!HoldsSlotReferences<T>::value,
+                "プールの参照を持つ型はバックグラウンドで破棄できません。");
+            BackgroundDestructor<T>::GetInstance();
+        }
+
+        // 予約プロファイルもプールより先に生成し、全てのプールの破棄後に書き出されるようにする
+        SlotReservationProfile::GetInstance().ApplyTo(*this);
+    }
+
+    /// 生存している要素だけを破棄する（削除済みスロットは破棄済みのため触れない）
+    /// 高速終了が有効なら要素の破棄とメモリの解放を省略する
+    virtual ~ObjectSlotSystemBase() {
+        SlotReservationProfile& profile = SlotReservationProfile::GetInstance();
+        if (profile.IsRecording()) {
+            profile.Record(*this);
+        }
+
+        if (SkipsTeardown()) {
+            m_data.abandon();
+            return;
+        }
+        DestroyAliveElements();
+    }
 
     /**
      * @brief ハンドルから要素を取得
@@ -101,23 +147,80 @@ public:
         }
     }
 
+    /**
+     * @brief 常駐メモリを抑えながら全ての有効な要素を先頭から順に処理する
+     *
+     * 物理メモリに収まらない大きなプールを走査する解析処理向け。
+     * 要素配列をwindowBytesごとの区間に分け、次の区間の先読み（MADV_WILLNEED）を
+     * 現在の区間の処理前に助言し、処理を終えた区間は回収の優先候補（MADV_COLD）に回す。
+     * スワップされたページを順に読み込みながら、走査による常駐メモリの増加を抑えられる。
+     *
+     * 助言は内容を変えないため、処理中に要素を書き換えてもよい。
+     * 助言に対応していない環境では通常のForEachと同じ動作になる。
+     *
+     * @param func func(SlotHandle, T&) の形で呼べる関数
+     * @param windowBytes 1区間のバイト数（ページサイズの数倍〜数MBを想定）
+     */
+    template<typename Func>
+    void StreamingForEach(Func&& func, size_t windowBytes) {
+        const size_t size = m_data.size();
+        if (size == 0) return;
+
+        void* base = static_cast<void*>(m_data.data());
+        const size_t window = windowBytes / sizeof(T) > 0 ? windowBytes / sizeof(T) : 1;
+
+        virtual_memory_allocator::advise_will_need(base, 0, std::min(window, size) * sizeof(T));
+        for (size_t begin = 0; begin < size; begin += window) {
+            const size_t end = std::min(begin + window, size);
+            if (end < size) {
+                virtual_memory_allocator::advise_will_need(base, end * sizeof(T), (std::min(end + window, size) - end) * sizeof(T));
+            }
+
+            for (size_t i = begin; i < end; ++i) {
+                if (m_alive[i]) {
+                    SlotHandle h{ static_cast<uint32_t>(i), m_generations[i] };
+                    func(h, m_data.get(i));
+                }
+            }
+
+            virtual_memory_allocator::advise_cold(base, begin * sizeof(T), (end - begin) * sizeof(T));
+        }
+    }
+
     /**
      * @brief プール内の全要素を削除
+     *
+     * 世代のエポックを進めるため、Clear前のハンドルや弱参照は
+     * 同じインデックスに新しく作成された要素とも一致しない。
+     * トリビアルに破棄可能な型ではスロットごとの処理を行わず、定数時間で完了する。
      */
     void Clear() {
-        m_data.clear();
+        DestroyAliveElements();
+        AdvanceEpoch();
         m_generations.clear();
         m_alive.clear();
         m_refCounts.clear();
-        m_freeList = std::queue<uint32_t>();
+        m_freeList.clear();
         m_count = 0;
+
+        // 全スロットが消えたため、次のチェックポイントは全体書き出しからやり直す
+        m_dirty.clear();
+        m_checkpointBaseWritten = false;
+        m_createdAt.clear();
+        ClearCycleRoots();
+        if (m_allocationSampler) m_allocationSampler->ResetLive();
     }
 
     /**
      * @brief 指定した数の要素分のメモリを事前確保
      */
-    void Reserve(size_t capacity) {
-        m_data.reserve(capacity);
+    void Reserve(size_t capacity, bool prefault = false) {
+        if (prefault) {
+            m_data.reserve_prefaulted(capacity);
+        }
+        else {
+            m_data.reserve(capacity);
+        }
         m_generations.reserve(capacity);
         m_alive.reserve(capacity);
         m_refCounts.reserve(capacity);
@@ -134,9 +237,14 @@ public:
 
         if (newSize == m_data.size()) return;
 
-        m_data.resize(newSize);
+        // 末尾の削除済みスロットはRemoveInternalで破棄済みのため、デストラクタを呼ばずに切り詰める
+        NotePeakCommitted();
+        m_data.truncate_destroyed(newSize);
         m_data.shrink_to_fit();
 
+        // 切り詰めたスロットを指す古いハンドルが、再追加された要素と一致しないようにする
+        AdvanceEpoch();
+
         m_generations.resize(newSize);
         m_generations.shrink_to_fit();
 
@@ -146,18 +254,627 @@ public:
         m_refCounts.resize(newSize);
         m_refCounts.shrink_to_fit();
 
-        std::queue<uint32_t> newFreeList;
-        while (!m_freeList.empty()) {
-            uint32_t index = m_freeList.front();
-            m_freeList.pop();
-            if (index < newSize) {
-                newFreeList.push(index);
+        if (m_createdAt.size() > newSize) {
+            m_createdAt.resize(newSize);
+        }
+
+        m_freeList.erase(std::remove_if(m_freeList.begin(), m_freeList.end(),
+            [newSize](uint32_t index) { return index >= newSize; }), m_freeList.end());
+    }
+
+    /**
+     * @brief 削除済みスロットだけのページの物理メモリを返却する
+     *
+     * 末尾を切り詰めるShrinkToFitと違い、使用中の領域の内側にある空きページも対象にする。
+     * 連続する削除済みスロットと、末尾のコミット済みで未使用の領域を
+     * ページ単位で破棄する（MADV_DONTNEED / MEM_RESET）。
+     * アドレスはそのまま使え、スロットを再利用したときに改めて物理メモリが割り当てられる。
+     * 削除済みスロットの内容は破棄済みで、再利用時に構築し直すため失われるものはない。
+     *
+     * @return 破棄したバイト数（ページ単位、仮想メモリ非対応の環境では常に0）
+     */
+    size_t DiscardFreePages() {
+#if defined(ROOT_VECTOR_STABLE_ADDRESS)
+        if (m_data.committed_bytes() == 0) return 0;
+
+        void* base = static_cast<void*>(m_data.data());
+        size_t discarded = 0;
+        size_t i = 0;
+        while (i < m_data.size()) {
+            if (m_alive[i]) {
+                ++i;
+                continue;
+            }
+            const size_t begin = i;
+            while (i < m_data.size() && !m_alive[i]) {
+                ++i;
+            }
+            discarded += DiscardRange(base, begin * sizeof(T), i * sizeof(T));
+        }
+        discarded += DiscardRange(base, m_data.size() * sizeof(T), m_data.committed_bytes());
+        return discarded;
+#else
+        // 仮想メモリ非対応の環境ではページ単位で返却できない
+        return 0;
+#endif
+    }
+
+    /**
+     * @brief 末尾の未使用スロットの縮小と、内側の空きページの破棄をまとめて行う
+     *
+     * @return 減ったバイト数（MemoryUsageBytes()の差と破棄したバイト数の合計）
+     */
+    size_t ReleaseUnusedMemory() override {
+        const size_t before = MemoryUsageBytes();
+        ShrinkToFit();
+        const size_t discarded = DiscardFreePages();
+        const size_t after = MemoryUsageBytes();
+        return (before > after ? before - after : 0) + discarded;
+    }
+
+    /**
+     * @brief 増分チェックポイント用の変更追跡を切り替える
+     *
+     * 有効な間は作成・削除・MarkDirty()されたスロットにダーティフラグを立て、
+     * WriteCheckpoint()はそのスロットだけを差分として書き出す。
+     * 切り替えると追跡状態は破棄され、次のチェックポイントは全体書き出しになる。
+     */
+    void SetCheckpointTracking(bool enabled) {
+        m_checkpointTracking = enabled;
+        m_checkpointBaseWritten = false;
+        m_dirty.clear();
+        UpdateDiagnostics();
+    }
+
+    /// 変更追跡が有効かどうかを取得
+    bool IsCheckpointTracking() const { return m_checkpointTracking; }
+
+    /// 要素の内容を変更したことを記録する（次のWriteCheckpointで書き出される）
+    void MarkDirty(SlotHandle handle) {
+        if (m_checkpointTracking && IsValidHandle(handle)) {
+            SetDirty(handle.index);
+        }
+    }
+
+    /**
+     * @brief 前回のチェックポイント以降に変化したスロットを書き出す
+     *
+     * 追記用のストリームに1ブロック分のレコードを書き出す。
+     * チェーンの最初（およびClear後）は削除済みも含む全スロットの全体ブロック、
+     * 以降は作成・変更・削除されたスロットだけを含む差分ブロックになる。
+     * 変化がない場合は何も書き出さない。
+     *
+     * 要素はバイト列のまま書き出すため、Tはトリビアルコピー可能である必要がある。
+     *
+     * @param out 書き出し先のストリーム（バイナリモード）
+     * @return 書き出したレコード数。追跡が無効な場合や書き込みに失敗した場合は0
+     */
+    size_t WriteCheckpoint(std::ostream& out) {
+        static_assert(std::is_trivially_copyable_v<T>,
+            "チェックポイントにはトリビアルコピー可能な型が必要です。");
+
+        if (!m_checkpointTracking) return 0;
+
+        const bool full = !m_checkpointBaseWritten;
+        std::vector<uint32_t> indices;
+        if (full) {
+            // 削除済みスロットもレコードだけ書き出し、インデックスを詰めたまま並べる
+            indices.resize(m_data.size());
+            for (size_t i = 0; i < indices.size(); ++i) {
+                indices[i] = static_cast<uint32_t>(i);
+            }
+        }
+        else {
+            for (size_t i = 0; i < m_dirty.size(); ++i) {
+                if (m_dirty[i]) indices.push_back(static_cast<uint32_t>(i));
+            }
+            if (indices.empty()) return 0;
+        }
+
+        CheckpointBlockHeader header{ CHECKPOINT_MAGIC, full ? CHECKPOINT_FULL : 0u,
+            sizeof(T), static_cast<uint64_t>(indices.size()) };
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        for (uint32_t index : indices) {
+            // ShrinkToFitで切り詰められたスロットは世代0の削除として記録する
+            const bool inRange = index < m_data.size();
+            const bool alive = inRange && m_alive[index];
+            CheckpointRecord record{ index, inRange ? m_generations[index] : 0u, alive ? 1u : 0u };
+            out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+            if (alive) {
+                out.write(reinterpret_cast<const char*>(&m_data.get(index)), sizeof(T));
+            }
+        }
+
+        if (!out) return 0;
+
+        m_dirty.assign(m_dirty.size(), false);
+        m_checkpointBaseWritten = true;
+        return indices.size();
+    }
+
+    /**
+     * @brief プール全体の状態を保持するスナップショット
+     *
+     * CloneState()で取得し、RestoreState()で書き戻す。
+     * 要素のバイト列とスロットのメタデータをそのまま保持する。
+     */
+    struct PoolState {
+        /** 要素のバイト列（スロット数 × sizeof(T)） */
+        std::vector<unsigned char> data;
+
+        /** 各スロットの世代番号 */
+        std::vector<uint32_t> generations;
+
+        /** 各スロットの生存フラグ */
+        std::vector<bool> alive;
+
+        /** 各スロットの参照カウント */
+        std::vector<uint32_t> refCounts;
+
+        /** 再利用可能なスロットのインデックス（取り出す順） */
+        std::vector<uint32_t> freeList;
+
+        /** 有効な要素数 */
+        size_t count = 0;
+
+        /// 保持しているスロット数を取得
+        size_t SlotCount() const { return generations.size(); }
+    };
+
+    /**
+     * @brief プールの現在の状態を複製する
+     *
+     * 使用中のスロット範囲の要素とメタデータを一括コピーする。
+     * ロールバック用に毎フレーム呼ぶ場合は、PoolStateを使い回す
+     * CloneState(PoolState&)の方がバッファの再確保を避けられる。
+     *
+     * @return 現在の状態のスナップショット
+     */
+    PoolState CloneState() const {
+        PoolState state;
+        CloneState(state);
+        return state;
+    }
+
+    /**
+     * @brief プールの現在の状態を既存のPoolStateに複製する
+     *
+     * 各配列は代入とassignでコピーするため、容量が足りていれば再確保しない。
+     *
+     * @param state 書き込み先（以前の内容は上書きされ、確保済みのバッファは再利用される）
+     */
+    void CloneState(PoolState& state) const {
+        static_assert(std::is_trivially_copyable_v<T>,
+            "CloneStateにはトリビアルコピー可能な型が必要です。");
+
+        const size_t size = m_data.size();
+        state.data.resize(size * sizeof(T));
+        if (size > 0) {
+            std::memcpy(state.data.data(), m_data.data(), size * sizeof(T));
+        }
+        state.generations = m_generations;
+        state.alive = m_alive;
+        state.refCounts = m_refCounts;
+        state.freeList.assign(m_freeList.begin(), m_freeList.end());
+        state.count = m_count;
+    }
+
+    /**
+     * @brief CloneState()で取得した状態にプールを巻き戻す
+     *
+     * 要素ごとの破棄・構築は行わず、要素とメタデータを一括コピーで書き戻す。
+     * インデックスと世代番号は複製時と完全に一致するため、
+     * 保存しておいたSlotHandleは巻き戻し後もそのまま使える。
+     *
+     * 参照カウントも複製時の値に戻る。複製後に作成・破棄したSlotPtrは
+     * 巻き戻されないため、巻き戻しをまたいで保持する参照には
+     * SlotHandleか弱参照を使うこと。
+     *
+     * スロットごとの付随データを持つ派生クラスは、OnStateRestored()で整える。
+     *
+     * @param state CloneState()で取得した状態
+     */
+    void RestoreState(const PoolState& state) {
+        static_assert(std::is_trivially_copyable_v<T>,
+            "RestoreStateにはトリビアルコピー可能な型が必要です。");
+
+        const size_t size = state.SlotCount();
+        assert(state.data.size() == size * sizeof(T));
+
+        if (m_data.size() > size) {
+            m_data.erase(m_data.begin() + size, m_data.end());
+        }
+        else {
+            m_data.reserve(size);
+            for (size_t i = m_data.size(); i < size; ++i) {
+                PushRawElement(&state.data[i * sizeof(T)]);
+            }
+        }
+        if (size > 0) {
+            std::memcpy(m_data.data(), state.data.data(), size * sizeof(T));
+        }
+
+        // 派生クラスが巻き戻しで入れ替わったスロットを判定できるよう、直前の状態を残しておく
+        std::vector<uint32_t> previousGenerations = std::move(m_generations);
+        std::vector<bool> previousAlive = std::move(m_alive);
+        m_generations = state.generations;
+        for (uint32_t generation : m_generations) {
+            NoteGeneration(generation);
+        }
+        m_alive = state.alive;
+        m_refCounts = state.refCounts;
+        m_freeList.assign(state.freeList.begin(), state.freeList.end());
+        m_count = state.count;
+
+        // 巻き戻した状態は差分の基準と一致しないため、次は全体書き出しにする
+        m_dirty.clear();
+        m_checkpointBaseWritten = false;
+
+        // 作成時刻と作成位置は巻き戻せないため不明として扱う
+        m_createdAt.clear();
+        if (m_allocationSampler) m_allocationSampler->ResetLive();
+
+        OnStateRestored(previousGenerations, previousAlive);
+    }
+
+    /// 診断出力用のプール名を設定（未設定なら型名を使う）
+    void SetPoolName(std::string name) { m_poolName = std::move(name); }
+
+    /// 診断出力用のプール名を取得
+    const char* PoolTypeName() const override {
+        return m_poolName.empty() ? typeid(T).name() : m_poolName.c_str();
+    }
+
+    /// 予約プロファイル用の型名（SetPoolNameの影響を受けない）
+    const char* PoolTypeKey() const override {
+        return typeid(T).name();
+    }
+
+    /// これまでのコミット済みバイト数のピーク
+    size_t PeakCommittedBytes() const override {
+        return std::max(m_peakCommittedBytes, m_data.committed_bytes());
+    }
+
+    /// 使用中のメモリ量（管理情報＋要素配列のコミット済み領域＋追跡用の配列）
+    size_t MemoryUsageBytes() const override {
+        return SlotControlBase::MemoryUsageBytes()
+            + m_data.committed_bytes()
+            + m_dirty.capacity() / 8
+            + m_createdAt.capacity() * sizeof(uint64_t)
+            + m_pendingRemovals.capacity() * sizeof(SlotHandle)
+            + (m_latency ? sizeof(SlotLatencyStats) : 0);
+    }
+
+    /**
+     * @brief 予約プロファイルに従って容量を確保する
+     *
+     * 確保数はプール自身の上限（SetMaxCapacity()の最大容量、インデックスの範囲、
+     * 予約済みの仮想アドレス空間）にだけ収める。最大容量を超える分は使われないため切り詰めても成功とする。
+     * プールの作成中にも呼ばれるため、確保の失敗は例外ではなく戻り値で伝える。
+     *
+     * @param count 確保する要素数
+     * @param prefault trueなら確保した領域のページを事前に割り当てる
+     * @return 要求どおりに確保できた場合はtrue。プールの上限で切り詰めた場合や確保に失敗した場合はfalse
+     */
+    bool ApplyReservation(size_t count, bool prefault) override {
+        if (m_maxCapacity != 0 && count > m_maxCapacity) {
+            count = m_maxCapacity;
+        }
+
+        bool complete = true;
+        if (count > SlotHandle::INVALID_INDEX) {
+            count = SlotHandle::INVALID_INDEX;
+            complete = false;
+        }
+        // 予約済みの仮想アドレス空間は後から拡張できないため、その範囲に収める
+        if (m_data.capacity() > 0 && count > m_data.capacity()) {
+            count = m_data.capacity();
+            complete = false;
+        }
+
+        try {
+            Reserve(count, prefault);
+        }
+        catch (const std::bad_alloc&) {
+            return false;
+        }
+        catch (const std::length_error&) {
+            return false;
+        }
+        return complete;
+    }
+
+    /**
+     * @brief 高速終了が有効でも、このプールの要素を破棄時に通常通り破棄させる
+     *
+     * デストラクタが外部に副作用を持つ（ファイルのフラッシュや接続の切断等）型のプールに使う。
+     */
+    void SetFlushOnExit(bool enabled) { m_flushOnExit = enabled; }
+
+    /// 高速終了時も通常通り破棄するかどうか
+    bool IsFlushOnExit() const { return m_flushOnExit; }
+
+    /// 破棄時に後片付けを省略するかどうか（SlotFastExit/UseFastExit/SetFlushOnExitから決まる）
+    bool SkipsTeardown() const {
+        return !m_flushOnExit && (UseFastExit<T>::value || SlotFastExit::IsEnabled());
+    }
+
+    /**
+     * @brief 循環参照の回収への参加を切り替える
+     *
+     * 有効にすると、参照カウントが0以外に減った要素を循環の候補として記録し、
+     * SlotCycleCollector::Collect()で外から到達できなくなった循環をまとめて解放できるようになる。
+     * Tは Trace(Visitor&) で持っているSlotPtrを列挙する必要がある（SlotCycleVisitor参照）。
+     * 無効の間の追加コストは、参照カウントの減算ごとのフラグ確認1回だけ。
+     */
+    void SetCycleCollection(bool enabled) {
+        static_assert(HasSlotCycleTrace<T>::value,
+            "循環参照の回収にはTrace(Visitor&)の実装が必要です。");
+        m_cycleCollecting = enabled;
+        if (!enabled) {
+            ClearCycleRoots();
+        }
+    }
+
+    /// 指定スロットの要素が持つSlotPtrを列挙する（Trace()を持たない型では何もしない）
+    void TraceSlotReferences(uint32_t index, SlotCycleVisitor& visitor) override {
+        if constexpr (HasSlotCycleTrace<T>::value) {
+            if (index < m_alive.size() && m_alive[index]) {
+                m_data.get(index).Trace(visitor);
+            }
+        }
+        else {
+            (void)index;
+            (void)visitor;
+        }
+    }
+
+    /**
+     * @brief 要素の作成時刻の記録を切り替える
+     *
+     * 有効にすると作成のたびに時刻を記録し、CollectOccupancy()で
+     * ページごとの最も古い生存要素の経過時間を求められるようになる。
+     * 有効にする前から存在する要素の経過時間は不明として扱う。
+     */
+    void SetAgeTracking(bool enabled) {
+        m_ageTracking = enabled;
+        if (!enabled) {
+            m_createdAt.clear();
+            m_createdAt.shrink_to_fit();
+        }
+        UpdateDiagnostics();
+    }
+
+    /// 作成時刻を記録しているかどうか
+    bool IsAgeTracking() const { return m_ageTracking; }
+
+    /**
+     * @brief ページごとの占有状況を集計する
+     *
+     * 要素配列をOSのページ単位で区切り、コミット済みの範囲と
+     * 使用中の範囲の両方を覆うページについて1件ずつ追加する。
+     * 生存・削除済みスロットの分布から、断片化や回収・圧縮の必要性を判断するために使う。
+     */
+    void CollectOccupancy(std::vector<SlotPageOccupancy>& pages) const override {
+        const size_t pageSize = virtual_memory_allocator::get_page_size();
+        const size_t usedBytes = m_data.size() * sizeof(T);
+        const size_t committedBytes = m_data.committed_bytes();
+        const size_t pageCount = (std::max(usedBytes, committedBytes) + pageSize - 1) / pageSize;
+
+        const size_t first = pages.size();
+        pages.resize(first + pageCount);
+        for (size_t p = 0; p < pageCount; ++p) {
+            SlotPageOccupancy& page = pages[first + p];
+            page.page = p;
+            page.firstSlot = (p * pageSize + sizeof(T) - 1) / sizeof(T);
+            page.committed = p * pageSize < committedBytes;
+        }
+
+        const uint64_t now = NowNs();
+        for (size_t i = 0; i < m_data.size(); ++i) {
+            SlotPageOccupancy& page = pages[first + i * sizeof(T) / pageSize];
+            ++page.slots;
+            if (!m_alive[i]) {
+                ++page.dead;
+                continue;
+            }
+            ++page.live;
+
+            if (i < m_createdAt.size() && m_createdAt[i] != SlotPageOccupancy::UNKNOWN_AGE) {
+                uint64_t age = now - m_createdAt[i];
+                if (page.oldestAgeNs == SlotPageOccupancy::UNKNOWN_AGE || age > page.oldestAgeNs) {
+                    page.oldestAgeNs = age;
+                }
             }
         }
-        m_freeList = std::move(newFreeList);
+    }
+
+    /**
+     * @brief 処理時間のヒストグラム記録を切り替える
+     *
+     * 有効にすると作成・削除（デストラクタを含む）の処理時間を記録する。
+     * SignalSlotSystem/RefSlotSystemでは購読者への通知時間と遅延削除の件数も記録する。
+     * 無効の間の追加コストはポインタの判定1回だけ。
+     * 切り替えると記録は破棄される。
+     */
+    void SetLatencyTracking(bool enabled) {
+        if (enabled) {
+            m_latency = std::make_unique<SlotLatencyStats>();
+        }
+        else {
+            m_latency.reset();
+        }
+        UpdateDiagnostics();
+    }
+
+    /// 処理時間を記録しているかどうか
+    bool IsLatencyTracking() const { return m_latency != nullptr; }
+
+    /// 処理時間の統計を取得（記録していなければnullptr）
+    const SlotLatencyStats* GetLatencyStats() const { return m_latency.get(); }
+
+    /// 処理時間の記録を消去する
+    void ResetLatencyStats() {
+        if (m_latency) m_latency->Reset();
+    }
+
+    /// 処理時間の統計の要約をプール名付きで書き出す
+    void DumpLatencyStats(std::ostream& out) const {
+        if (!m_latency) return;
+        out << "[" << PoolTypeName() << "]\n";
+        m_latency->Dump(out);
+    }
+
+    /**
+     * @brief 作成位置のサンプリングを切り替える
+     *
+     * interval回の作成ごとに1回、Create()の呼び出し元の位置を記録する。
+     * 生存している要素の推定数とバイト数を作成位置ごとに集計し、
+     * 要素を多く作っている箇所や解放漏れの箇所を特定するために使う。
+     * 無効の間の追加コストはポインタの判定1回だけ。
+     * 切り替えると記録は破棄され、有効にする前に作成された要素は集計されない。
+     *
+     * @param interval 何回の作成ごとに1回記録するか（0で無効）
+     */
+    void SetAllocationSampling(uint32_t interval) {
+        if (interval > 0) {
+            m_allocationSampler = std::make_unique<SlotAllocationSampler>(interval);
+        }
+        else {
+            m_allocationSampler.reset();
+        }
+        UpdateDiagnostics();
+    }
+
+    /// 作成位置の記録を取得（記録していなければnullptr）
+    const SlotAllocationSampler* GetAllocationSampler() const { return m_allocationSampler.get(); }
+
+    /// 作成位置ごとの推定生存数とバイト数をプール名付きで書き出す
+    void DumpAllocationSites(std::ostream& out) const {
+        if (!m_allocationSampler) return;
+        out << "[" << PoolTypeName() << "] 1/" << m_allocationSampler->Interval() << " sampling\n";
+        m_allocationSampler->Dump(out, sizeof(T));
     }
 
 protected:
+    /** チェックポイントブロックの識別子 ("OSCP") */
+    static constexpr uint32_t CHECKPOINT_MAGIC = 0x5043534F;
+
+    /** 全体ブロックを表すフラグ（再生時にそれまでの状態を破棄する） */
+    static constexpr uint32_t CHECKPOINT_FULL = 1;
+
+    /** チェックポイントブロックの先頭に置くヘッダ */
+    struct CheckpointBlockHeader {
+        uint32_t magic;
+        uint32_t flags;
+        uint64_t elementSize;
+        uint64_t recordCount;
+    };
+
+    /** 1スロット分のレコード（aliveなら直後に要素のバイト列が続く） */
+    struct CheckpointRecord {
+        uint32_t index;
+        uint32_t generation;
+        uint32_t alive;
+    };
+
+    /**
+     * @brief チェックポイント列を再生してスロットを再構築する
+     *
+     * 全ブロックを読み終えて最終状態が確定してから、空のプールに
+     * 元と同じインデックス・世代番号でスロットを並べ直す。
+     * 読み込みに失敗した場合はプールに一切触れない。
+     * 件数はストリームの残りのバイト数で、インデックスは再生中のスロット数で検証する。
+     * 書き出し側はスロットを詰めて記録するため、新しいインデックスは常に現在の末尾になる。
+     * 復元された要素の参照カウントは0のままなので、呼び出し側が所有権を与えること。
+     *
+     * @param in 読み込み元のストリーム（バイナリモード）
+     * @param restored 復元された有効スロットのインデックスの出力先
+     * @return 復元に成功した場合はtrue。プールに有効な要素がある場合やデータが不正な場合はfalse
+     */
+    bool RestoreCheckpointChain(std::istream& in, std::vector<uint32_t>& restored) {
+        static_assert(std::is_trivially_copyable_v<T>,
+            "チェックポイントにはトリビアルコピー可能な型が必要です。");
+
+        if (m_count != 0) return false;
+
+        const uint64_t streamBytes = StreamRemaining(in);
+        uint64_t consumed = 0;
+        std::vector<unsigned char> stagedBytes;
+        std::vector<uint32_t> stagedGenerations;
+        std::vector<bool> stagedAlive;
+        bool anyBlock = false;
+
+        CheckpointBlockHeader header;
+        while (in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            consumed += sizeof(header);
+            if (header.magic != CHECKPOINT_MAGIC || header.elementSize != sizeof(T)
+                || header.recordCount > (streamBytes - consumed) / sizeof(CheckpointRecord)) {
+                return false;
+            }
+            if (header.flags & CHECKPOINT_FULL) {
+                stagedBytes.clear();
+                stagedGenerations.clear();
+                stagedAlive.clear();
+            }
+
+            for (uint64_t r = 0; r < header.recordCount; ++r) {
+                CheckpointRecord record;
+                if (!in.read(reinterpret_cast<char*>(&record), sizeof(record))) return false;
+                consumed += sizeof(record);
+                if (record.index > stagedGenerations.size()) return false;
+
+                if (record.index == stagedGenerations.size()) {
+                    size_t newSize = static_cast<size_t>(record.index) + 1;
+                    stagedBytes.resize(newSize * sizeof(T));
+                    stagedGenerations.resize(newSize, 0);
+                    stagedAlive.resize(newSize, false);
+                }
+                stagedGenerations[record.index] = record.generation;
+                stagedAlive[record.index] = (record.alive != 0);
+
+                if (record.alive != 0) {
+                    char* dst = reinterpret_cast<char*>(&stagedBytes[record.index * sizeof(T)]);
+                    if (!in.read(dst, sizeof(T))) return false;
+                    consumed += sizeof(T);
+                }
+            }
+            anyBlock = true;
+        }
+        if (!anyBlock) return false;
+
+        // 末尾の削除済みスロットは持ち越さない（ShrinkToFit後の状態と一致させる）
+        size_t size = stagedAlive.size();
+        while (size > 0 && !stagedAlive[size - 1]) {
+            --size;
+        }
+
+        Clear();
+        Reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            PushRawElement(&stagedBytes[i * sizeof(T)]);
+            m_generations.push_back(stagedGenerations[i]);
+            NoteGeneration(stagedGenerations[i]);
+            m_alive.push_back(stagedAlive[i]);
+            m_refCounts.push_back(0);
+
+            if (stagedAlive[i]) {
+                restored.push_back(static_cast<uint32_t>(i));
+                ++m_count;
+            }
+            else {
+                m_data.get(i).~T();
+                m_freeList.push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        // 復元した状態をチェーンの続きとして扱い、以降は差分を追記できるようにする
+        m_checkpointBaseWritten = m_checkpointTracking;
+        if (m_allocationSampler) m_allocationSampler->ResetLive();
+        return true;
+    }
+
     /**
      * @brief 新しい要素用のスロットを確保
      *
@@ -170,11 +887,150 @@ protected:
      * @return 確保されたスロットのハンドル
      */
     SlotHandle AllocateSlot(T&& obj) {
+        if (!m_diagnostics) {
+            return PlaceElement(std::move(obj));
+        }
+
+        const uint64_t startNs = m_latency ? NowNs() : 0;
+        const SlotHandle handle = PlaceElement(std::move(obj));
+
+        if (m_checkpointTracking) {
+            SetDirty(handle.index);
+        }
+
+        if (m_ageTracking) {
+            if (handle.index >= m_createdAt.size()) {
+                m_createdAt.resize(static_cast<size_t>(handle.index) + 1, SlotPageOccupancy::UNKNOWN_AGE);
+            }
+            m_createdAt[handle.index] = NowNs();
+        }
+
+        if (m_latency) {
+            m_latency->create.Record(NowNs() - startNs);
+        }
+        return handle;
+    }
+
+    /**
+     * @brief 要素を削除する内部処理
+     *
+     * 削除処理の実行中（要素のデストラクタや購読者への通知の中）に呼ばれた場合は
+     * 削除を遅延キューに追加するだけで戻り、最外の削除処理の完了後にまとめて実行する。
+     * SlotPtrで互いを所有する連結リストや木を解放しても
+     * ReleaseRef→RemoveInternal→~T→ReleaseRef の再帰が起きず、
+     * 構造の深さに関係なくスタックの使用量は一定になる。
+     * 遅延キューはプールごとに持つため、同じ型の要素は幅優先でまとめて削除される。
+     *
+     * 遅延された要素は、実際に削除されるまで参照カウント0のまま生存している。
+     *
+     * @param handle 削除する要素のハンドル
+     */
+    void RemoveInternal(SlotHandle handle) override {
+        if (m_removalDepth > 0) {
+            m_pendingRemovals.push_back(handle);
+            return;
+        }
+
+        ++m_removalDepth;
+        RemoveNow(handle);
+        FinishRemovalScope();
+    }
+
+    /**
+     * @brief RestoreState()の最後に呼ばれる
+     *
+     * 派生クラスはスロットごとの付随データ（購読リストなど）を巻き戻し後の状態に合わせるためにオーバーライドする。
+     *
+     * @param previousGenerations 巻き戻す直前の各スロットの世代番号
+     * @param previousAlive 巻き戻す直前の各スロットの生存フラグ
+     */
+    virtual void OnStateRestored(const std::vector<uint32_t>& previousGenerations,
+        const std::vector<bool>& previousAlive) {
+        (void)previousGenerations;
+        (void)previousAlive;
+    }
+
+    /**
+     * @brief 実際の削除処理を実行する
+     *
+     * 要素を破棄してスロットを無効化し、有効な診断機能に削除を記録する。
+     * 派生クラスは通知やSlotRefの無効化を追加するためにオーバーライドし、
+     * コンストラクタでm_plainRemovalをfalseにする。
+     *
+     * @param handle 削除する要素のハンドル
+     */
+    virtual void ExecuteRemoval(SlotHandle handle) {
+        SlotTraceScope trace("Destroy", *this, handle.index, 0);
+        const uint64_t startNs = m_latency ? NowNs() : 0;
+        DestroySlot(handle);
+
+        if (m_checkpointTracking) {
+            SetDirty(handle.index);
+        }
+
+        if (m_allocationSampler) {
+            m_allocationSampler->Release(handle.index);
+        }
+
+        if (m_latency) {
+            m_latency->release.Record(NowNs() - startNs);
+        }
+    }
+
+    /**
+     * @brief 削除処理の区間を終える
+     *
+     * 最外の区間であれば、区間中に遅延された削除をまとめて実行する。
+     * 区間の開始は m_removalDepth のインクリメントで行う。
+     */
+    void FinishRemovalScope() {
+        if (m_removalDepth == 1 && !m_pendingRemovals.empty()) {
+            ProcessPendingRemovals();
+        }
+        --m_removalDepth;
+    }
+
+    /** 要素の連続配置ストレージ（ネイティブ環境ではアドレス不変） */
+    root_vector<T> m_data;
+
+    /** 処理時間の統計（記録していなければnullptr） */
+    std::unique_ptr<SlotLatencyStats> m_latency;
+
+    /** 作成位置のサンプリング記録（記録していなければnullptr） */
+    std::unique_ptr<SlotAllocationSampler> m_allocationSampler;
+
+    /// 作成のたびに呼び、サンプリングの対象なら作成位置を記録する
+    void SampleAllocation(uint32_t index, const SlotCallSite& site) {
+        if (m_allocationSampler && m_allocationSampler->ShouldSample()) {
+            m_allocationSampler->Record(index, site);
+        }
+    }
+
+    /// 経過時間の計測に使う現在時刻（ナノ秒）
+    static uint64_t NowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /** 削除処理のネスト深度（0なら削除処理中でない） */
+    uint32_t m_removalDepth = 0;
+
+    /** ExecuteRemovalをオーバーライドしていない（要素の破棄だけで削除が完結する）場合はtrue */
+    bool m_plainRemoval = true;
+
+private:
+    /**
+     * @brief 要素をスロットに配置する（診断機能の記録を含まない作成の本体）
+     *
+     * @param obj 格納する要素（ムーブされる）
+     * @return 確保されたスロットのハンドル
+     */
+    SlotHandle PlaceElement(T&& obj) {
         SlotHandle handle;
 
         if (!m_freeList.empty()) {
             handle.index = m_freeList.front();
-            m_freeList.pop();
+            m_freeList.pop_front();
             handle.generation = m_generations[handle.index];
 
             new (&m_data.get(handle.index)) T(std::move(obj));
@@ -183,10 +1039,10 @@ protected:
         }
         else {
             handle.index = static_cast<uint32_t>(m_data.size());
-            handle.generation = 0;
+            handle.generation = InitialGeneration();
 
             m_data.push_back(std::move(obj));
-            m_generations.push_back(0);
+            m_generations.push_back(handle.generation);
             m_alive.push_back(true);
             m_refCounts.push_back(0);
         }
@@ -196,28 +1052,191 @@ protected:
         }
 
         ++m_count;
+        if (m_count > m_peakCount) {
+            m_peakCount = m_count;
+        }
         return handle;
     }
 
     /**
-     * @brief 要素を削除する内部処理
+     * @brief 要素を破棄してスロットを無効化する（診断機能の記録を含まない削除の本体）
      *
-     * 要素のデストラクタを呼び出してスロットを無効化する。
      * デフォルトTの構築は行わない（次のAllocateSlotでplacement newするため）。
      *
+     * UseBackgroundDestruction<T>が有効な型は、要素をスロットからムーブで取り出して
+     * BackgroundDestructorに渡し、スロットにはムーブ後の抜け殻だけを残して破棄する。
+     * 重いデストラクタは別スレッドで実行され、スロットは即座に再利用可能になる。
+     *
      * @param handle 削除する要素のハンドル
      */
-    void RemoveInternal(SlotHandle handle) override {
+    void DestroySlot(SlotHandle handle) {
         m_alive[handle.index] = false;
-        ++m_generations[handle.index];
+        AdvanceGeneration(handle.index);
         m_refCounts[handle.index] = 0;
 
+        if constexpr (UseBackgroundDestruction<T>::value) {
+            BackgroundDestructor<T>::GetInstance().Enqueue(std::move(m_data.get(handle.index)));
+        }
         m_data.get(handle.index).~T();
 
-        m_freeList.push(handle.index);
+        m_freeList.push_back(handle.index);
         --m_count;
+
+        // スロットを再利用した要素が循環の候補になれるよう、候補フラグを下ろす
+        if (handle.index < m_cycleRootBuffered.size()) {
+            m_cycleRootBuffered[handle.index] = false;
+        }
     }
 
-    /** 要素の連続配置ストレージ（ネイティブ環境ではアドレス不変） */
-    root_vector<T> m_data;
+    /**
+     * @brief 1つの要素を今すぐ削除する
+     *
+     * 派生クラスが削除処理を拡張しておらず、診断機能も記録も無効なら、
+     * 仮想関数を経由せずに要素の破棄だけを行う。
+     */
+    void RemoveNow(SlotHandle handle) {
+        if (m_plainRemoval && !m_diagnostics && !SlotTraceRecorder::IsEnabled()) {
+            DestroySlot(handle);
+        }
+        else {
+            ExecuteRemoval(handle);
+        }
+    }
+
+    /// いずれかの診断機能が有効かどうかを更新する（各機能の切り替え時に呼ぶ）
+    void UpdateDiagnostics() {
+        m_diagnostics = m_checkpointTracking || m_ageTracking || m_latency || m_allocationSampler;
+    }
+
+private:
+    /// ページ境界に狭めた範囲を破棄し、破棄したバイト数を返す
+    static size_t DiscardRange(void* base, size_t beginBytes, size_t endBytes) {
+        const size_t pageSize = virtual_memory_allocator::get_page_size();
+        const size_t alignedBegin = (beginBytes + pageSize - 1) & ~(pageSize - 1);
+        const size_t alignedEnd = endBytes & ~(pageSize - 1);
+        if (alignedBegin >= alignedEnd) return 0;
+
+        virtual_memory_allocator::discard(base, alignedBegin, alignedEnd - alignedBegin);
+        return alignedEnd - alignedBegin;
+    }
+
+    /// 縮小前のコミット済みバイト数をピークに反映する
+    void NotePeakCommitted() {
+        if (m_data.committed_bytes() > m_peakCommittedBytes) {
+            m_peakCommittedBytes = m_data.committed_bytes();
+        }
+    }
+
+    /**
+     * @brief 遅延された削除処理をまとめて実行する
+     *
+     * 削除処理中にRemoveInternalが呼ばれた場合、削除対象はm_pendingRemovalsに蓄積される。
+     * 遅延削除の実行中にさらに遅延削除が発生する可能性があるため、
+     * キューが空になるまで世代ごとに（幅優先で）ループする。
+     */
+    void ProcessPendingRemovals() {
+        if (m_pendingRemovals.empty()) return;
+        SlotTraceScope trace("ProcessPendingRemovals", *this, SlotHandle::INVALID_INDEX,
+            static_cast<uint32_t>(m_pendingRemovals.size()));
+
+        uint64_t batchSize = 0;
+        while (!m_pendingRemovals.empty()) {
+            // ローカルにムーブしてからループ
+            // （ExecuteRemoval中に新たなpending追加が起きても安全）
+            std::vector<SlotHandle> pending = std::move(m_pendingRemovals);
+            m_pendingRemovals.clear();
+
+            for (const SlotHandle& handle : pending) {
+                // 既に削除済み、または弱参照から再び参照されたものは削除しない
+                if (IsValidHandle(handle) && m_refCounts[handle.index] == 0) {
+                    RemoveNow(handle);
+                    ++batchSize;
+                }
+            }
+        }
+
+        if (m_latency && batchSize > 0) {
+            m_latency->removalBatch.Record(batchSize);
+        }
+    }
+
+    /**
+     * @brief 生存している要素を破棄してストレージを空にする
+     *
+     * 削除済みスロットの要素はRemoveInternalで破棄済みのため、二重に破棄しない。
+     * 破棄中の要素が同じプールの別の要素を解放しても安全なように、
+     * デストラクタを呼ぶ前に生存フラグを下ろす。
+     * トリビアルに破棄可能な型ではスロットを走査しない。
+     */
+    void DestroyAliveElements() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = 0; i < m_data.size(); ++i) {
+                if (m_alive[i]) {
+                    m_alive[i] = false;
+                    m_data.get(i).~T();
+                }
+            }
+        }
+        m_data.truncate_destroyed(0);
+    }
+
+    /// 読み込み位置からストリームの末尾までのバイト数（シークできなければ上限なし）
+    static uint64_t StreamRemaining(std::istream& in) {
+        const std::streampos begin = in.tellg();
+        if (begin == std::streampos(-1)) return UINT64_MAX;
+        in.seekg(0, std::ios::end);
+        const std::streampos end = in.tellg();
+        in.seekg(begin);
+        if (end == std::streampos(-1) || !in.good()) {
+            in.clear();
+            in.seekg(begin);
+            return UINT64_MAX;
+        }
+        return static_cast<uint64_t>(end - begin);
+    }
+
+    /// バイト列から要素を1つ末尾に追加する（トリビアルコピー可能な型専用）
+    void PushRawElement(const unsigned char* bytes) {
+        alignas(T) unsigned char buffer[sizeof(T)];
+        std::memcpy(buffer, bytes, sizeof(T));
+        m_data.push_back(*std::launder(reinterpret_cast<T*>(buffer)));
+    }
+
+    /// 指定スロットにダーティフラグを立てる
+    void SetDirty(uint32_t index) {
+        if (index >= m_dirty.size()) {
+            m_dirty.resize(static_cast<size_t>(index) + 1, false);
+        }
+        m_dirty[index] = true;
+    }
+
+    /** 前回のチェックポイント以降に変化したスロットのフラグ */
+    std::vector<bool> m_dirty;
+
+    /** チェックポイント用の変更追跡が有効かどうか */
+    bool m_checkpointTracking = false;
+
+    /** 現在のチェーンに全体ブロックを書き出し済みかどうか */
+    bool m_checkpointBaseWritten = false;
+
+    /** 診断出力用のプール名（空なら型名を使う） */
+    std::string m_poolName;
+
+    /** 作成時刻を記録するかどうか */
+    bool m_ageTracking = false;
+
+    /** 作成・削除時に記録する診断機能（変更追跡・作成時刻・処理時間・作成位置）のいずれかが有効かどうか */
+    bool m_diagnostics = false;
+
+    /** 各スロットの要素の作成時刻（ナノ秒、不明ならUNKNOWN_AGE） */
+    std::vector<uint64_t> m_createdAt;
+
+    /** 削除処理中に発生した遅延削除キュー */
+    std::vector<SlotHandle> m_pendingRemovals;
+
+    /** 高速終了時も通常通り破棄するかどうか */
+    bool m_flushOnExit = false;
+
+    /** 縮小前に記録したコミット済みバイト数のピーク */
+    size_t m_peakCommittedBytes = 0;
 };
\ No newline at end of file
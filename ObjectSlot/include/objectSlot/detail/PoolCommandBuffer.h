@@ -0,0 +1,356 @@
+#pragma once
+
+#include "SlotHandle.h"
+#include "SlotPtr.h"
+#include "SignalSlotPtr.h"
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <utility>
+
+/**
+ * @brief コマンドバッファ内で作成予約された要素を識別する仮ハンドル
+ *
+ * PoolCommandBuffer::Create()が返す。
+ * 適用前はバッファ内の作成コマンドの通し番号を表し、
+ * 適用後はPoolCommandResult::Resolve()で本物のSlotHandleに解決できる。
+ * 仮ハンドルは発行したバッファ内でのみ有効。
+ */
+struct ProvisionalHandle {
+    /** バッファ内の作成コマンドの通し番号 */
+    uint32_t index = SlotHandle::INVALID_INDEX;
+
+    /// 仮ハンドルが有効かどうかを判定
+    bool IsValid() const { return index != SlotHandle::INVALID_INDEX; }
+};
+
+/**
+ * @brief コマンドバッファの適用結果
+ *
+ * 作成コマンドで生成された要素の所有ポインタと、
+ * 仮ハンドルから解決された本物のハンドルを保持する。
+ * objects/handlesのインデックスは仮ハンドルの通し番号と一致する。
+ *
+ * @tparam Ptr プールのCreate()が返すポインタ型（SlotPtr / SignalSlotPtr）
+ */
+template<typename Ptr>
+struct PoolCommandResult {
+    /** 作成された要素の所有ポインタ（作成失敗・同一バッファ内で解放済みの場合は空） */
+    std::vector<Ptr> objects;
+
+    /** 仮ハンドルに対応する本物のハンドル（作成失敗時は無効ハンドル） */
+    std::vector<SlotHandle> handles;
+
+    /// 仮ハンドルを本物のハンドルに解決する
+    SlotHandle Resolve(ProvisionalHandle provisional) const {
+        if (!provisional.IsValid() || provisional.index >= handles.size()) {
+            return SlotHandle::Invalid();
+        }
+        return handles[provisional.index];
+    }
+};
+
+/**
+ * @brief ワーカースレッドからのプール操作を記録するコマンドバッファ
+ *
+ * プールはスレッドセーフではないため、並列ジョブから直接Create/解放すると
+ * 外部同期が必要になる。このバッファは操作をローカルに記録するだけで
+ * プールに一切触れないため、ワーカーごとに1つ持てばロック不要で使える。
+ *
+ * 記録した操作は同期ポイントでApply()/ApplyAll()により一括適用する。
+ * 適用順序は次の通り:
+ * 1. 作成（記録順。仮ハンドルが本物のハンドルに解決される）
+ * 2. 変更（スロットインデックス順に安定ソートして1パスで実行）
+ * 3. 解放（スロットインデックス順に1パスで実行）
+ *
+ * 同じ要素への変更は記録順（ApplyAllではバッファの並び順→記録順）で実行される。
+ *
+ * 使用例:
+ * @code
+ *   PoolCommandBuffer<Mesh> cmd;                 // ワーカースレッド側
+ *   auto p = cmd.Create(Mesh{ "Spawned" });
+ *   cmd.Modify(p, [](Mesh& m) { m.vertexCount = 8; });
+ *   cmd.Release(std::move(oldMesh));             // SlotPtrの所有権をバッファへ移す
+ *
+ *   auto result = cmd.Apply(ObjectSlotSystem<Mesh>::GetInstance());   // メインスレッド側
+ *   SlotPtr<Mesh>& spawned = result.objects[p.index];
+ * @endcode
+ *
+ * 注意事項:
+ * - 1つのバッファを複数スレッドから同時に使用しないこと
+ * - Apply()はプールを所有するスレッドから呼ぶこと
+ * - Release()に渡したポインタは適用時に解放される。
+ *   適用せずにバッファを破棄すると、破棄したスレッドで解放が走る
+ *
+ * @tparam T プール内で管理される要素の型
+ */
+template<typename T>
+class PoolCommandBuffer {
+public:
+    /** 変更コマンドで実行する関数の型 */
+    using ModifyFunc = std::function<void(T&)>;
+
+    PoolCommandBuffer() = default;
+
+    // コピー禁止
+    PoolCommandBuffer(const PoolCommandBuffer&) = delete;
+    PoolCommandBuffer& operator=(const PoolCommandBuffer&) = delete;
+
+    // ムーブ可能
+    PoolCommandBuffer(PoolCommandBuffer&&) noexcept = default;
+    PoolCommandBuffer& operator=(PoolCommandBuffer&&) noexcept = default;
+
+    /**
+     * @brief 作成コマンドを記録する
+     *
+     * @param obj 作成する要素（バッファ内にムーブされる）
+     * @return 適用後に本物のハンドルへ解決できる仮ハンドル
+     */
+    ProvisionalHandle Create(T&& obj) {
+        ProvisionalHandle provisional;
+        provisional.index = static_cast<uint32_t>(m_creates.size());
+        m_creates.push_back(std::move(obj));
+        return provisional;
+    }
+
+    /**
+     * @brief 同じバッファで作成予約した要素の解放コマンドを記録する
+     *
+     * 適用時、作成された要素の所有ポインタが結果から取り除かれる。
+     */
+    void Release(ProvisionalHandle target) {
+        if (target.IsValid() && target.index < m_creates.size()) {
+            m_provisionalReleases.push_back(target.index);
+        }
+    }
+
+    /**
+     * @brief 既存要素の参照の解放コマンドを記録する
+     *
+     * ポインタの所有権をバッファに移すだけで、参照カウントには触れない。
+     * 実際の参照カウント減少は適用時に行われる。
+     */
+    void Release(SlotPtr<T>&& ptr) {
+        if (ptr) {
+            m_releasedPtrs.push_back(std::move(ptr));
+        }
+    }
+
+    /// 既存要素の参照の解放コマンドを記録する（SignalSlotPtr版）
+    void Release(SignalSlotPtr<T>&& ptr) {
+        if (ptr) {
+            m_releasedSignalPtrs.push_back(std::move(ptr));
+        }
+    }
+
+    /**
+     * @brief 既存要素の変更コマンドを記録する
+     *
+     * 適用時にハンドルが無効になっていた場合は実行されない。
+     *
+     * @param target 変更対象のハンドル
+     * @param func 要素を受け取って変更する関数
+     */
+    void Modify(SlotHandle target, ModifyFunc func) {
+        m_modifies.push_back({ target, SlotHandle::INVALID_INDEX, std::move(func) });
+    }
+
+    /**
+     * @brief 同じバッファで作成予約した要素の変更コマンドを記録する
+     *
+     * @param target 変更対象の仮ハンドル
+     * @param func 要素を受け取って変更する関数
+     */
+    void Modify(ProvisionalHandle target, ModifyFunc func) {
+        if (target.IsValid() && target.index < m_creates.size()) {
+            m_modifies.push_back({ SlotHandle::Invalid(), target.index, std::move(func) });
+        }
+    }
+
+    /// 記録されたコマンドの総数を取得
+    size_t CommandCount() const {
+        return m_creates.size() + m_modifies.size() + m_provisionalReleases.size()
+            + m_releasedPtrs.size() + m_releasedSignalPtrs.size();
+    }
+
+    /// コマンドが記録されていないか判定
+    bool IsEmpty() const { return CommandCount() == 0; }
+
+    /**
+     * @brief 記録された全コマンドを破棄する
+     *
+     * Release()で預かったポインタはこの時点で解放される。
+     */
+    void Clear() {
+        m_creates.clear();
+        m_modifies.clear();
+        m_provisionalReleases.clear();
+        m_releasedPtrs.clear();
+        m_releasedSignalPtrs.clear();
+    }
+
+    /**
+     * @brief 記録されたコマンドをプールに適用する
+     *
+     * 適用後、バッファは空になり再利用できる。
+     *
+     * @tparam Pool 適用先のプール型（ObjectSlotSystem / SignalSlotSystem / RefSlotSystem）
+     * @param pool 適用先のプール
+     * @return 作成された要素の所有ポインタと解決済みハンドル
+     */
+    template<typename Pool>
+    auto Apply(Pool& pool) {
+        std::vector<PoolCommandBuffer*> buffers{ this };
+        auto results = ApplyAll(pool, buffers);
+        return std::move(results.front());
+    }
+
+    /**
+     * @brief 複数のバッファをまとめてプールに適用する
+     *
+     * 全バッファの作成をバッファ順に実行した後、
+     * 全バッファの変更・解放をスロットインデックス順に並べ替えて
+     * それぞれ1パスで実行する。
+     * インデックス順に処理することでプールのメモリを先頭から順に走査できる。
+     *
+     * @param pool 適用先のプール
+     * @param buffers 適用するバッファの一覧（nullptrは無視される）
+     * @return バッファごとの適用結果（buffersと同じ並び）
+     */
+    template<typename Pool>
+    static auto ApplyAll(Pool& pool, const std::vector<PoolCommandBuffer*>& buffers) {
+        using PtrType = decltype(pool.Create(std::declval<T&&>()));
+        std::vector<PoolCommandResult<PtrType>> results(buffers.size());
+
+        // 1. 作成（仮ハンドルを本物のハンドルに解決する）
+        for (size_t b = 0; b < buffers.size(); ++b) {
+            if (buffers[b] == nullptr) continue;
+            auto& creates = buffers[b]->m_creates;
+            auto& result = results[b];
+            result.objects.reserve(creates.size());
+            result.handles.reserve(creates.size());
+            for (auto& obj : creates) {
+                PtrType ptr = pool.Create(std::move(obj));
+                result.handles.push_back(ptr ? ptr.GetHandle() : SlotHandle::Invalid());
+                result.objects.push_back(std::move(ptr));
+            }
+        }
+
+        // 2. 変更（インデックス順に安定ソートして1パスで実行）
+        std::vector<PendingModify> modifies;
+        for (size_t b = 0; b < buffers.size(); ++b) {
+            if (buffers[b] == nullptr) continue;
+            for (auto& command : buffers[b]->m_modifies) {
+                SlotHandle target = command.target;
+                if (command.provisional != SlotHandle::INVALID_INDEX) {
+                    target = results[b].handles[command.provisional];
+                }
+                if (target.IsValid()) {
+                    modifies.push_back({ target, &command.func });
+                }
+            }
+        }
+        std::stable_sort(modifies.begin(), modifies.end(),
+            [](const PendingModify& a, const PendingModify& b) {
+                return a.target.index < b.target.index;
+            });
+        for (auto& pending : modifies) {
+            T* obj = pool.Get(pending.target);
+            if (obj != nullptr && *pending.func) {
+                (*pending.func)(*obj);
+            }
+        }
+
+        // 3. 解放（インデックス順に1パスで実行）
+        std::vector<PendingRelease<PtrType>> createdReleases;
+        std::vector<SlotPtr<T>*> slotReleases;
+        std::vector<SignalSlotPtr<T>*> signalReleases;
+        for (size_t b = 0; b < buffers.size(); ++b) {
+            if (buffers[b] == nullptr) continue;
+            auto* buffer = buffers[b];
+            for (uint32_t provisional : buffer->m_provisionalReleases) {
+                auto& ptr = results[b].objects[provisional];
+                if (ptr) {
+                    createdReleases.push_back({ ptr.GetHandle().index, &ptr });
+                }
+            }
+            for (auto& ptr : buffer->m_releasedPtrs) {
+                slotReleases.push_back(&ptr);
+            }
+            for (auto& ptr : buffer->m_releasedSignalPtrs) {
+                signalReleases.push_back(&ptr);
+            }
+        }
+        std::sort(createdReleases.begin(), createdReleases.end(),
+            [](const PendingRelease<PtrType>& a, const PendingRelease<PtrType>& b) {
+                return a.index < b.index;
+            });
+        for (auto& pending : createdReleases) {
+            pending.ptr->Reset();
+        }
+        // プール内の要素は連続配置のため、アドレス順はインデックス順と一致する
+        std::sort(slotReleases.begin(), slotReleases.end(),
+            [](const SlotPtr<T>* a, const SlotPtr<T>* b) { return *a < *b; });
+        for (auto* ptr : slotReleases) {
+            ptr->Reset();
+        }
+        std::sort(signalReleases.begin(), signalReleases.end(),
+            [](const SignalSlotPtr<T>* a, const SignalSlotPtr<T>* b) { return *a < *b; });
+        for (auto* ptr : signalReleases) {
+            ptr->Reset();
+        }
+
+        for (auto* buffer : buffers) {
+            if (buffer != nullptr) {
+                buffer->Clear();
+            }
+        }
+        return results;
+    }
+
+private:
+    /**
+     * @brief 変更コマンド
+     *
+     * 対象は既存要素のハンドル、または同じバッファの仮ハンドルのどちらか。
+     * 仮ハンドルを使わない場合はprovisionalがINVALID_INDEXになる。
+     */
+    struct ModifyCommand {
+        /** 変更対象のハンドル（既存要素の場合） */
+        SlotHandle target;
+
+        /** 変更対象の仮ハンドル番号（作成予約した要素の場合） */
+        uint32_t provisional;
+
+        /** 要素を変更する関数 */
+        ModifyFunc func;
+    };
+
+    /// 適用時に並べ替える変更コマンド
+    struct PendingModify {
+        SlotHandle target;
+        ModifyFunc* func;
+    };
+
+    /// 適用時に並べ替える作成済み要素の解放コマンド
+    template<typename Ptr>
+    struct PendingRelease {
+        uint32_t index;
+        Ptr* ptr;
+    };
+
+    /** 作成予約された要素 */
+    std::vector<T> m_creates;
+
+    /** 変更コマンド */
+    std::vector<ModifyCommand> m_modifies;
+
+    /** 作成予約した要素の解放コマンド（仮ハンドル番号） */
+    std::vector<uint32_t> m_provisionalReleases;
+
+    /** 解放を預かったSlotPtr */
+    std::vector<SlotPtr<T>> m_releasedPtrs;
+
+    /** 解放を預かったSignalSlotPtr */
+    std::vector<SignalSlotPtr<T>> m_releasedSignalPtrs;
+};
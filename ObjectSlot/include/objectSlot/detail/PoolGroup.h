@@ -0,0 +1,53 @@
+#pragma once
+
+#include "RefSlotSystem.h"
+#include <type_traits>
+
+/**
+ * @brief 共通の基底型を持つ複数のプールをまとめて走査するグループ
+ *
+ * SlotRef<Base>のリストを走査すると、異なるプールの要素が混ざるため
+ * アクセス先が飛び、呼び出しも毎回仮想関数経由になる。
+ * PoolGroupは具体型ごとのRefSlotSystemを順に連続走査し、
+ * コールバックには静的な具体型の参照を渡す。
+ *
+ * コールバックをジェネリックラムダにすると具体型ごとに別の関数として実体化され、
+ * 具体型がfinalであれば仮想関数呼び出しはコンパイラにより直接呼び出しになる。
+ * finalでない型では obj.Derived::Method() のように修飾して呼ぶと同じ効果が得られる。
+ *
+ * 使用例:
+ * @code
+ *   using Drawables = PoolGroup<IDrawable, Mesh, Sprite>;
+ *   Drawables::ForEach([](SlotHandle, auto& drawable) {
+ *       drawable.Draw();
+ *   });
+ * @endcode
+ *
+ * 走査順は具体型の列挙順、各プール内ではインデックス順になる。
+ *
+ * @tparam Base 共通の基底型
+ * @tparam Derived グループに含める具体型
+ */
+template<typename Base, typename... Derived>
+class PoolGroup {
+    static_assert(sizeof...(Derived) > 0, "PoolGroupには1つ以上の具体型を指定してください。");
+    static_assert((std::is_base_of_v<Base, Derived> && ...), "全ての具体型はBaseを継承している必要があります。");
+
+public:
+    PoolGroup() = delete;
+
+    /**
+     * @brief 全ての具体型の有効な要素に対して処理を実行
+     *
+     * @param func func(SlotHandle, Derived&) の形で呼べる関数（通常はジェネリックラムダ）
+     */
+    template<typename Func>
+    static void ForEach(Func&& func) {
+        (RefSlotSystem<Derived>::GetInstance().ForEach(func), ...);
+    }
+
+    /// グループ全体の有効な要素数を取得
+    static size_t Count() {
+        return (RefSlotSystem<Derived>::GetInstance().Count() + ...);
+    }
+};
\ No newline at end of file
@@ -29,10 +29,11 @@ public:
     }
 
     /// 新しい要素を作成しSignalSlotPtrを返す
-    SignalSlotPtr<T> Create(T&& obj) {
-        if (!this->CanCreate()) return SignalSlotPtr<T>();
+    SignalSlotPtr<T> Create(T&& obj, SlotCallSite site = SlotCallSite::Current()) {
+        if (!this->PrepareCreate()) return SignalSlotPtr<T>();
         
         SlotHandle handle = this->AllocateSlot(std::move(obj));
+        this->SampleAllocation(handle.index, site);
         ++this->m_refCounts[handle.index];
         auto rp = this->GetRootPointer(handle.index);
         return SignalSlotPtr<T>(rp, this);
@@ -42,6 +42,7 @@ public:
      * @param slotIndex このSlotRefが指すスロットのインデックス
      */
     void RegisterRef(void** ptrLocation, uint32_t slotIndex) override {
+        BackgroundDestructionThread::CheckNotCurrent();
         EnsureSlotCapacity(slotIndex);
         m_refEntriesPerSlot[slotIndex].push_back({ ptrLocation, slotIndex });
     }
@@ -57,6 +58,7 @@ public:
      * @return 対応するスロットインデックス。見つからない場合はINVALID_INDEX
      */
     uint32_t UnregisterRef(void** ptrLocation) override {
+        BackgroundDestructionThread::CheckNotCurrent();
         // ポインタ値からスロットインデックスを算出して直接検索を試みる
         if (*ptrLocation != nullptr) {
             T* ptr = static_cast<T*>(*ptrLocation);
@@ -203,33 +205,25 @@ protected:
     }
 
     /**
-     * @brief 要素を削除する内部処理
+     * @brief 実際の削除処理を実行する
      *
-     * まず基底クラスの削除処理を呼ぶ。
-     * 基底が遅延削除を選択した場合（通知ループ中）、
-     * 要素はまだ生存しているためSlotRefの無効化は行わない。
-     * 遅延削除が後で実行される際に再びこの関数が呼ばれ、
-     * その時点でSlotRefが無効化される。
-     *
-     * 基底が即座に削除を実行した場合は、
+     * まず基底クラスの削除処理（購読者への通知と要素の破棄）を呼び、
      * 通知完了後にSlotRefのポインタをnullptrに設定する。
      * これにより購読者のコールバック内でSlotRef経由のアクセスが可能になる。
      *
+     * 遅延キューから実行される削除もここを通るため、遅延された要素のSlotRefも確実に無効化される。
+     * 解放待ちの待機側は全ての削除が終わってから再開されるので、再開時にはSlotRefの無効化が済んでいる。
+     *
      * @param handle 削除する要素のハンドル
      */
-    void RemoveInternal(SlotHandle handle) override {
-        // 基底の処理（遅延される可能性がある）
-        SignalSlotSystemBase<T>::RemoveInternal(handle);
-
-        // 基底が遅延削除を選択した場合、要素はまだ生存している
-        // m_aliveがfalseなら実際に削除が実行されたので、SlotRefを無効化する
-        if (handle.index < this->m_alive.size() && !this->m_alive[handle.index]) {
-            if (handle.index < m_refEntriesPerSlot.size()) {
-                for (auto& entry : m_refEntriesPerSlot[handle.index]) {
-                    *entry.ptrLocation = nullptr;
-                }
-                m_refEntriesPerSlot[handle.index].clear();
+    void ExecuteRemoval(SlotHandle handle) override {
+        SignalSlotSystemBase<T>::ExecuteRemoval(handle);
+
+        if (handle.index < m_refEntriesPerSlot.size()) {
+            for (auto& entry : m_refEntriesPerSlot[handle.index]) {
+                *entry.ptrLocation = nullptr;
             }
+            m_refEntriesPerSlot[handle.index].clear();
         }
     }
 
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "SignalSlotSystemBase.h"
+#include "SignalSlotPtr.h"
+
+#if defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+
+/**
+ * @brief 要素の解放を待つC++20コルーチン用のAwaiter
+ *
+ * SignalSlotPtr::Released()またはWeakSignalSlotPtr::Released()が返す。
+ * co_awaitすると、対象の要素が解放されるまでコルーチンを中断する。
+ *
+ * Awaiter自身が待機ノードを持ち、プールの待機リストにつなぐだけなので、
+ * 待機・再開のどちらでもメモリ確保を行わない（std::functionも使わない）。
+ * 再開は要素のデストラクタと購読者への通知が完了した後、
+ * 遅延削除の処理（ProcessPendingRemovals）と同じ経路から行われる。
+ * 既に解放済みの要素を待った場合は中断せずにそのまま進む。
+ *
+ * 待つ側のコルーチンが同じ要素の強参照を保持していると解放が起きないため、
+ * 待つ側では弱参照（WeakSignalSlotPtr）から待つこと。
+ *
+ * 使用例:
+ * @code
+ *   Task RebuildOnRelease(WeakSignalSlotPtr<Device> device) {
+ *       co_await device.Released();
+ *       // ここでは元のDeviceは破棄済み
+ *   }
+ * @endcode
+ *
+ * @tparam T 待機対象の要素の型
+ */
+template<typename T>
+class ReleaseAwaiter : private ReleaseWaitNode {
+public:
+    /**
+     * @brief コンストラクタ
+     *
+     * @param slot 要素が属するプール（nullptrなら即座に完了する）
+     * @param handle 解放を待つ要素のハンドル
+     */
+    ReleaseAwaiter(SignalSlotSystemBase<T>* slot, SlotHandle handle)
+        : m_slot(slot)
+        , m_handle(handle)
+    {
+        this->resume = &ReleaseAwaiter::ResumeNode;
+    }
+
+    /// 再開前に破棄された場合は待機リストから外す
+    ~ReleaseAwaiter() {
+        if (m_slot != nullptr) {
+            m_slot->RemoveReleaseWaiter(this);
+        }
+    }
+
+    // コピー・ムーブ禁止（待機ノードのアドレスをプールが保持するため）
+    ReleaseAwaiter(const ReleaseAwaiter&) = delete;
+    ReleaseAwaiter& operator=(const ReleaseAwaiter&) = delete;
+    ReleaseAwaiter(ReleaseAwaiter&&) = delete;
+    ReleaseAwaiter& operator=(ReleaseAwaiter&&) = delete;
+
+    /// 要素が既に解放済みなら中断しない
+    bool await_ready() const noexcept {
+        return m_slot == nullptr || !m_slot->IsValidHandle(m_handle);
+    }
+
+    /// プールの待機リストに登録して中断する
+    void await_suspend(std::coroutine_handle<> coroutine) {
+        m_coroutine = coroutine;
+        m_slot->AddReleaseWaiter(m_handle.index, this);
+    }
+
+    /// 再開時には何も返さない
+    void await_resume() const noexcept {}
+
+private:
+    /// プールから呼ばれる再開関数
+    static void ResumeNode(ReleaseWaitNode* node) {
+        static_cast<ReleaseAwaiter*>(node)->m_coroutine.resume();
+    }
+
+    /** 要素が属するプール */
+    SignalSlotSystemBase<T>* m_slot;
+
+    /** 解放を待つ要素のハンドル */
+    SlotHandle m_handle;
+
+    /** 中断中のコルーチン */
+    std::coroutine_handle<> m_coroutine;
+};
+
+template<typename T>
+ReleaseAwaiter<T> SignalSlotPtr<T>::Released() const {
+    return ReleaseAwaiter<T>(m_slot, GetHandle());
+}
+
+template<typename T>
+ReleaseAwaiter<T> WeakSignalSlotPtr<T>::Released() const {
+    return ReleaseAwaiter<T>(m_slot, m_handle);
+}
+
+#endif
\ No newline at end of file
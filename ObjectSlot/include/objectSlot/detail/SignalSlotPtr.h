@@ -12,6 +12,11 @@ class SignalSlotSystemBase;
 template<typename T>
 class WeakSignalSlotPtr;
 
+#if defined(__cpp_impl_coroutine)
+template<typename T>
+class ReleaseAwaiter;
+#endif
+
 class SlotControlBase;
 
 /**
@@ -189,6 +194,16 @@ public:
         return Subscription<T>(m_slot, index, id);
     }
 
+#if defined(__cpp_impl_coroutine)
+    /**
+     * @brief 要素の解放をco_awaitで待つためのAwaiterを取得
+     *
+     * このポインタ自身が強参照を持っているため、待つ側のコルーチンでは
+     * GetWeak()で得た弱参照のReleased()を使うこと。
+     */
+    ReleaseAwaiter<T> Released() const;
+#endif
+
     /// 等価比較（ポインタアドレスで比較）
     bool operator==(const SignalSlotPtr& other) const {
         return m_root_ptr.get() == other.m_root_ptr.get();
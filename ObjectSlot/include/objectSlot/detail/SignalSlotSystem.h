@@ -2,6 +2,7 @@
 
 #include "SignalSlotSystemBase.h"
 #include "SignalSlotPtr.h"
+#include "ReleaseAwaiter.h"
 
 /**
  * @brief シングルトンパターンの通知機能付きオブジェクトプール
@@ -25,15 +26,42 @@ public:
     }
 
     /// 新しい要素を作成しSignalSlotPtrを返す
-    SignalSlotPtr<T> Create(T&& obj) {
-        if (!this->CanCreate()) return SignalSlotPtr<T>();
+    SignalSlotPtr<T> Create(T&& obj, SlotCallSite site = SlotCallSite::Current()) {
+        if (!this->PrepareCreate()) return SignalSlotPtr<T>();
         
         SlotHandle handle = this->AllocateSlot(std::move(obj));
+        this->SampleAllocation(handle.index, site);
         ++this->m_refCounts[handle.index];
         auto rp = this->GetRootPointer(handle.index);
         return SignalSlotPtr<T>(rp, this);
     }
 
+    /**
+     * @brief WriteCheckpoint()で書き出したチェックポイント列を再生してプールを復元
+     *
+     * 全体ブロックと差分ブロックを先頭から順に適用し、最終状態を
+     * 元と同じインデックス・世代番号で再構築する。
+     * 保存しておいたSlotHandleは復元後もそのまま使える。
+     *
+     * @param in 読み込み元のストリーム（バイナリモード）
+     * @return 復元された要素のSignalSlotPtr（インデックス順）。
+     *         プールに有効な要素がある場合やデータが不正な場合は空を返し、プールは変更しない
+     */
+    std::vector<SignalSlotPtr<T>> LoadCheckpointChain(std::istream& in) {
+        std::vector<SignalSlotPtr<T>> result;
+        std::vector<uint32_t> restored;
+        if (!this->RestoreCheckpointChain(in, restored)) return result;
+
+        this->m_subscriptions.assign(this->m_data.size(), typename SignalSlotSystemBase<T>::SlotSubscriptions{});
+        this->m_subscriptionCount = 0;
+        result.reserve(restored.size());
+        for (uint32_t index : restored) {
+            ++this->m_refCounts[index];
+            result.push_back(SignalSlotPtr<T>(this->GetRootPointer(index), this));
+        }
+        return result;
+    }
+
     // コピー・ムーブ禁止
     SignalSlotSystem(const SignalSlotSystem&) = delete;
     SignalSlotSystem& operator=(const SignalSlotSystem&) = delete;
@@ -14,6 +14,40 @@ class WeakSignalSlotPtr;
 template<typename T>
 class Subscription;
 
+template<typename T>
+class ReleaseAwaiter;
+
+/**
+ * @brief 解放待ちの待機ノード
+ *
+ * 要素の解放を待つ側（ReleaseAwaiter等）が自身に埋め込んで使う侵入型リストのノード。
+ * プールはノードをつなぎ替えるだけでメモリ確保を行わず、
+ * 解放後に関数ポインタresumeを呼んで待機側を再開する。
+ */
+struct ReleaseWaitNode {
+    /** 待機ノードの状態 */
+    enum class State : uint8_t {
+        Idle,     ///< どのリストにも属していない
+        Waiting,  ///< スロットの解放を待っている
+        Ready     ///< 解放済みで再開待ちキューにある
+    };
+
+    /** 前のノード */
+    ReleaseWaitNode* prev = nullptr;
+
+    /** 次のノード */
+    ReleaseWaitNode* next = nullptr;
+
+    /** 解放後に呼ばれる再開関数 */
+    void (*resume)(ReleaseWaitNode* node) = nullptr;
+
+    /** 待機中のスロットインデックス */
+    uint32_t slotIndex = SlotHandle::INVALID_INDEX;
+
+    /** 現在の状態 */
+    State state = State::Idle;
+};
+
 /**
  * @brief 通知機能付きオブジェクトプールの基底クラス
  *
@@ -36,23 +70,44 @@ class SignalSlotSystemBase : public ObjectSlotSystemBase<T> {
     friend class SignalSlotPtr<T>;
     friend class WeakSignalSlotPtr<T>;
     friend class Subscription<T>;
+    friend class ReleaseAwaiter<T>;
 
 public:
     /** 購読コールバックの型（引数なし） */
     using SubscriptionCallback = std::function<void()>;
 
+    /// 削除時に購読者へ通知するため、削除は常にExecuteRemovalを経由させる
+    SignalSlotSystemBase() {
+        this->m_plainRemoval = false;
+    }
+
     virtual ~SignalSlotSystemBase() = default;
 
     /// 全要素に通知した後、プールを初期化する
     void Clear() {
-        for (size_t i = 0; i < this->m_data.size(); ++i) {
-            if (this->m_alive[i]) {
-                NotifySubscribers(static_cast<uint32_t>(i));
+        // 一度も購読されていなければ通知と購読リストの初期化を省く
+        // （購読リストは全て空のままなので、スロット再利用時の初期化に任せる）
+        if (m_hasSubscriptions) {
+            for (size_t i = 0; i < this->m_data.size(); ++i) {
+                if (this->m_alive[i]) {
+                    NotifySubscribers(static_cast<uint32_t>(i));
+                }
             }
         }
 
         ObjectSlotSystemBase<T>::Clear();
-        m_subscriptions.clear();
+        if (m_hasSubscriptions) {
+            m_subscriptions.clear();
+            m_hasSubscriptions = false;
+            m_subscriptionCount = 0;
+        }
+
+        // 解放を待っている全ての待機側を再開する
+        for (size_t i = 0; i < m_releaseWaiters.size(); ++i) {
+            QueueReleaseWaiters(static_cast<uint32_t>(i));
+        }
+        m_releaseWaiters.clear();
+        ResumeReleaseWaiters();
     }
 
     /// メモリを事前確保する（購読リストも含む）
@@ -75,6 +130,26 @@ public:
         }
     }
 
+    /// 末尾の未使用スロットの縮小（購読リストも含む）と、内側の空きページの破棄をまとめて行う
+    size_t ReleaseUnusedMemory() override {
+        const size_t before = this->MemoryUsageBytes();
+        ShrinkToFit();
+        const size_t discarded = this->DiscardFreePages();
+        const size_t after = this->MemoryUsageBytes();
+        return (before > after ? before - after : 0) + discarded;
+    }
+
+    /// 有効な購読の数（全スロットの合計）
+    size_t SubscriptionCount() const { return m_subscriptionCount; }
+
+    /// 使用中のメモリ量（基底の分＋購読リスト）
+    size_t MemoryUsageBytes() const override {
+        return ObjectSlotSystemBase<T>::MemoryUsageBytes()
+            + m_subscriptions.capacity() * sizeof(SlotSubscriptions)
+            + m_subscriptionCount * sizeof(SubscriptionEntry)
+            + m_releaseWaiters.capacity() * sizeof(ReleaseWaitNode*);
+    }
+
 protected:
     /**
      * @brief 購読エントリ
@@ -119,6 +194,7 @@ protected:
     SlotHandle AllocateSlot(T&& obj) {
         SlotHandle handle = ObjectSlotSystemBase<T>::AllocateSlot(std::move(obj));
         if (handle.index < m_subscriptions.size()) {
+            m_subscriptionCount -= m_subscriptions[handle.index].entries.size();
             m_subscriptions[handle.index] = SlotSubscriptions{};
         }
         else {
@@ -130,25 +206,106 @@ protected:
     /**
      * @brief 要素を削除する内部処理
      *
-     * 通知ループ中に参照カウントが0になった場合は
-     * 削除を遅延キューに追加し、通知完了後にまとめて実行する。
+     * 削除処理や通知ループの中で参照カウントが0になった場合は
+     * 基底の遅延キューに追加され、最外の処理の完了後にまとめて実行される。
      * これにより再帰的なRemoveInternalの呼び出しを防止する。
      *
-     * 通常の呼び出し時はExecuteRemovalに委譲し、
-     * 購読者への逆順通知→購読リストクリア→基底の削除処理の順に実行する。
+     * 削除はExecuteRemovalで
+     * 購読者への逆順通知→購読リストクリア→基底の削除処理の順に実行し、
+     * 全ての削除が終わってから解放を待っていた待機側を再開する。
      *
      * @param handle 削除する要素のハンドル
      */
     void RemoveInternal(SlotHandle handle) override {
-        // 通知ループ中なら削除を遅延させる
-        if (m_notifyDepth > 0) {
-            m_pendingRemovals.push_back(handle);
-            return;
+        ObjectSlotSystemBase<T>::RemoveInternal(handle);
+        if (this->m_removalDepth == 0) {
+            ResumeReleaseWaiters();
+        }
+    }
+
+    /**
+     * @brief RestoreState()による巻き戻しの後に購読リストを空にし、解放待ちを整理する
+     *
+     * 購読は巻き戻しの対象外で、全スロットの購読リストは空になる。
+     * 巻き戻し後に通知が必要な場合は購読し直すこと。
+     * 巻き戻しで待機対象の要素が消えた（または別の要素に入れ替わった）スロットの待機側は、
+     * Clear()と同じく解放されたものとして再開する。
+     */
+    void OnStateRestored(const std::vector<uint32_t>& previousGenerations,
+        const std::vector<bool>& previousAlive) override {
+        m_subscriptions.assign(this->m_data.size(), SlotSubscriptions{});
+        m_subscriptionCount = 0;
+
+        for (size_t i = 0; i < m_releaseWaiters.size(); ++i) {
+            const bool wasAlive = i < previousAlive.size() && previousAlive[i];
+            const bool sameElement = wasAlive && i < this->m_alive.size() && this->m_alive[i]
+                && this->m_generations[i] == previousGenerations[i];
+            if (!sameElement) {
+                QueueReleaseWaiters(static_cast<uint32_t>(i));
+            }
+        }
+        if (m_releaseWaiters.size() > this->m_data.size()) {
+            m_releaseWaiters.resize(this->m_data.size());
+        }
+        ResumeReleaseWaiters();
+    }
+
+    /**
+     * @brief 実際の削除処理を実行する
+     *
+     * 購読者への逆順通知を実行した後、
+     * 購読リストをクリアし、基底クラスの削除処理を呼ぶ。
+     * 解放を待っていた待機側は再開待ちキューに移す。
+     *
+     * @param handle 削除する要素のハンドル
+     */
+    void ExecuteRemoval(SlotHandle handle) override {
+        const uint32_t subscribers = handle.index < m_subscriptions.size()
+            ? static_cast<uint32_t>(m_subscriptions[handle.index].entries.size()) : 0;
+        SlotTraceScope trace("ExecuteRemoval", *this, handle.index, subscribers);
+
+        NotifySubscribers(handle.index);
+        if (handle.index < m_subscriptions.size()) {
+            m_subscriptionCount -= m_subscriptions[handle.index].entries.size();
+            m_subscriptions[handle.index] = SlotSubscriptions{};
         }
+        ObjectSlotSystemBase<T>::ExecuteRemoval(handle);
+        QueueReleaseWaiters(handle.index);
+    }
+
+    /**
+     * @brief 再開待ちキューの待機側を順に再開する
+     *
+     * 再開された側がさらに要素を解放しても再帰せず、
+     * 新たに再開待ちになった分は同じループで続けて処理する。
+     * 再開の処理中に呼ばれた場合は何もしない（外側のループが続けて処理する）。
+     */
+    void ResumeReleaseWaiters() {
+        if (m_waiterResumeBlock > 0) return;
+
+        ++m_waiterResumeBlock;
+        while (m_readyHead != nullptr) {
+            ReleaseWaitNode* node = m_readyHead;
+            m_readyHead = node->next;
+            if (m_readyHead != nullptr) {
+                m_readyHead->prev = nullptr;
+            }
+            else {
+                m_readyTail = nullptr;
+            }
+            node->prev = nullptr;
+            node->next = nullptr;
+            node->state = ReleaseWaitNode::State::Idle;
 
-        ExecuteRemoval(handle);
+            // 再開により待機側（とnode）が破棄される可能性があるため、以降nodeに触れない
+            node->resume(node);
+        }
+        --m_waiterResumeBlock;
     }
 
+    /** 待機側を再開している最中かどうかの深度（0なら再開可能） */
+    uint32_t m_waiterResumeBlock = 0;
+
     /**
      * @brief 購読を追加
      *
@@ -162,7 +319,9 @@ protected:
     uint32_t AddSubscription(uint32_t slotIndex, SubscriptionCallback callback) {
         auto& subs = m_subscriptions[slotIndex];
         uint32_t id = subs.nextId++;
+        m_hasSubscriptions = true;
         subs.entries.push_back({ id, std::move(callback), false });
+        ++m_subscriptionCount;
         return id;
     }
 
@@ -197,6 +356,7 @@ protected:
                 [subscriptionId](const SubscriptionEntry& entry) {
                     return entry.id == subscriptionId;
                 });
+            m_subscriptionCount -= static_cast<size_t>(entries.end() - it);
             entries.erase(it, entries.end());
         }
     }
@@ -250,8 +410,12 @@ protected:
         auto& subs = m_subscriptions[slotIndex];
         if (subs.entries.empty()) return;
 
+        const uint64_t startNs = this->m_latency ? this->NowNs() : 0;
+
         // 通知深度を増加（リエントランシー検出用）
+        // 通知中の解放は基底の遅延キューに積ませる
         ++m_notifyDepth;
+        ++this->m_removalDepth;
 
         // ループ開始時のサイズをキャプチャ（通知中の追加分は対象外）
         // インデックスベースの逆順走査でイテレータ無効化を回避する
@@ -266,16 +430,22 @@ protected:
         // 通知深度を減少
         --m_notifyDepth;
 
+        if (this->m_latency) {
+            this->m_latency->notify.Record(this->NowNs() - startNs);
+        }
+
         // キャンセル済みエントリを一括削除
         auto newEnd = std::remove_if(subs.entries.begin(), subs.entries.end(),
             [](const SubscriptionEntry& entry) {
                 return entry.cancelled;
             });
+        m_subscriptionCount -= static_cast<size_t>(subs.entries.end() - newEnd);
         subs.entries.erase(newEnd, subs.entries.end());
 
-        // 最外の通知ループが完了したら遅延削除を実行
-        if (m_notifyDepth == 0) {
-            ProcessPendingRemovals();
+        // 最外の処理であれば遅延削除を実行し、解放を待っていた待機側を再開する
+        this->FinishRemovalScope();
+        if (this->m_removalDepth == 0) {
+            ResumeReleaseWaiters();
         }
     }
 
@@ -286,6 +456,7 @@ protected:
      * 既存のRemoveSubscriptionに委譲する。
      */
     void RemoveSubscriptionByIndex(uint32_t slotIndex, uint32_t subscriptionId) override {
+        BackgroundDestructionThread::CheckNotCurrent();
         RemoveSubscription(slotIndex, subscriptionId);
     }
 
@@ -296,59 +467,111 @@ protected:
      * 既存のUpdateSubscriptionCallbackに委譲する。
      */
     void UpdateSubscriptionCallbackByIndex(uint32_t slotIndex, uint32_t subscriptionId, std::function<void()> callback) override {
+        BackgroundDestructionThread::CheckNotCurrent();
         UpdateSubscriptionCallback(slotIndex, subscriptionId, std::move(callback));
     }
 
     /** 各スロットの購読リスト */
     std::vector<SlotSubscriptions> m_subscriptions;
 
+    /** 前回のClear以降に購読が追加されたか */
+    bool m_hasSubscriptions = false;
+
+    /** 有効な購読の数（全スロットの合計、メモリ使用量の算出用） */
+    size_t m_subscriptionCount = 0;
+
 private:
     /**
-     * @brief 実際の削除処理を実行する
+     * @brief 解放待ちの待機ノードを登録する
      *
-     * 購読者への逆順通知を実行した後、
-     * 購読リストをクリアし、基底クラスの削除処理を呼ぶ。
+     * スロットごとの待機リストの先頭に追加する。
+     * 再開は購読の通知と同じく登録の逆順になる。
      *
-     * @param handle 削除する要素のハンドル
+     * @param slotIndex 解放を待つスロットのインデックス
+     * @param node 待機側に埋め込まれたノード
      */
-    void ExecuteRemoval(SlotHandle handle) {
-        NotifySubscribers(handle.index);
-        if (handle.index < m_subscriptions.size()) {
-            m_subscriptions[handle.index] = SlotSubscriptions{};
+    void AddReleaseWaiter(uint32_t slotIndex, ReleaseWaitNode* node) {
+        if (slotIndex >= m_releaseWaiters.size()) {
+            m_releaseWaiters.resize(static_cast<size_t>(slotIndex) + 1, nullptr);
         }
-        ObjectSlotSystemBase<T>::RemoveInternal(handle);
+        ReleaseWaitNode*& head = m_releaseWaiters[slotIndex];
+        node->prev = nullptr;
+        node->next = head;
+        if (head != nullptr) {
+            head->prev = node;
+        }
+        head = node;
+        node->slotIndex = slotIndex;
+        node->state = ReleaseWaitNode::State::Waiting;
     }
 
     /**
-     * @brief 遅延された削除処理をまとめて実行する
+     * @brief 待機ノードを所属するリストから外す
      *
-     * 通知ループ中にRemoveInternalが呼ばれた場合、
-     * 削除対象はm_pendingRemovalsに蓄積される。
-     * 最外の通知ループ完了後にこの関数が呼ばれ、
-     * 蓄積された削除を順次実行する。
+     * 再開前に待機側が破棄される場合に呼ばれる。
+     */
+    void RemoveReleaseWaiter(ReleaseWaitNode* node) {
+        if (node->state == ReleaseWaitNode::State::Idle) return;
+
+        if (node->prev != nullptr) {
+            node->prev->next = node->next;
+        }
+        else if (node->state == ReleaseWaitNode::State::Waiting) {
+            m_releaseWaiters[node->slotIndex] = node->next;
+        }
+        else {
+            m_readyHead = node->next;
+        }
+
+        if (node->next != nullptr) {
+            node->next->prev = node->prev;
+        }
+        else if (node->state == ReleaseWaitNode::State::Ready) {
+            m_readyTail = node->prev;
+        }
+
+        node->prev = nullptr;
+        node->next = nullptr;
+        node->state = ReleaseWaitNode::State::Idle;
+    }
+
+    /**
+     * @brief 指定スロットの待機リストを再開待ちキューの末尾に移す
      *
-     * 遅延削除の実行中にさらに遅延削除が発生する可能性があるため、
-     * キューが空になるまでループする。
+     * @param slotIndex 解放されたスロットのインデックス
      */
-    void ProcessPendingRemovals() {
-        while (!m_pendingRemovals.empty()) {
-            // ローカルにムーブしてからループ
-            // （ExecuteRemoval中に新たなpending追加が起きても安全）
-            auto pending = std::move(m_pendingRemovals);
-            m_pendingRemovals.clear();
-
-            for (auto& handle : pending) {
-                // 既に削除済みかもしれないので検証する
-                if (this->IsValidHandle(handle)) {
-                    ExecuteRemoval(handle);
-                }
-            }
+    void QueueReleaseWaiters(uint32_t slotIndex) {
+        if (slotIndex >= m_releaseWaiters.size()) return;
+
+        ReleaseWaitNode* node = m_releaseWaiters[slotIndex];
+        if (node == nullptr) return;
+        m_releaseWaiters[slotIndex] = nullptr;
+
+        for (ReleaseWaitNode* n = node; n != nullptr; n = n->next) {
+            n->state = ReleaseWaitNode::State::Ready;
+        }
+        if (m_readyTail != nullptr) {
+            m_readyTail->next = node;
+            node->prev = m_readyTail;
         }
+        else {
+            m_readyHead = node;
+        }
+        while (node->next != nullptr) {
+            node = node->next;
+        }
+        m_readyTail = node;
     }
 
     /** 通知ループのネスト深度（0なら通知中でない） */
     uint32_t m_notifyDepth = 0;
 
-    /** 通知ループ中に発生した遅延削除キュー */
-    std::vector<SlotHandle> m_pendingRemovals;
+    /** 各スロットの解放待ちリストの先頭（待機側が現れたインデックスまでだけ確保する） */
+    std::vector<ReleaseWaitNode*> m_releaseWaiters;
+
+    /** 再開待ちキューの先頭 */
+    ReleaseWaitNode* m_readyHead = nullptr;
+
+    /** 再開待ちキューの末尾 */
+    ReleaseWaitNode* m_readyTail = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 要素を作成した呼び出し元の位置
+ *
+ * Create()の既定引数でCurrent()を評価すると、Create()を呼び出した行が記録される。
+ * ファイル名と関数名はコンパイラが埋め込む文字列リテラルを指すため、コピーのコストはない。
+ */
+struct SlotCallSite {
+    /** ソースファイル名 */
+    const char* file = "unknown";
+
+    /** 関数名 */
+    const char* function = "unknown";
+
+    /** 行番号 */
+    uint32_t line = 0;
+
+#if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1926)
+    /// 呼び出し元の位置を取得する（既定引数として使うと、その関数の呼び出し元になる）
+    static constexpr SlotCallSite Current(
+        const char* file = __builtin_FILE(),
+        const char* function = __builtin_FUNCTION(),
+        uint32_t line = __builtin_LINE()) {
+        return SlotCallSite{ file, function, line };
+    }
+#else
+    /// 呼び出し元の位置を取得できない環境では"unknown"を返す
+    static constexpr SlotCallSite Current() {
+        return SlotCallSite{};
+    }
+#endif
+};
+
+/**
+ * @brief 作成位置ごとの集計
+ */
+struct SlotAllocationSiteStats {
+    /** 作成位置 */
+    SlotCallSite site;
+
+    /** サンプリングした作成の数 */
+    uint64_t sampledCreates = 0;
+
+    /** サンプリングした要素のうち、まだ生存しているものの数 */
+    uint64_t sampledLive = 0;
+};
+
+/**
+ * @brief 作成位置のサンプリング記録
+ *
+ * N回に1回の作成について作成位置を記録し、スロットごとに作成位置の番号を保持する。
+ * 要素が削除されると、その作成位置の生存数を減らす。
+ * 生存数が減らない作成位置は、解放漏れ（またはキャッシュの肥大化）の候補になる。
+ *
+ * 記録しない作成のコストはカウンタの減算と分岐だけなので、
+ * 1/1000程度の間隔なら本番環境で有効にしたままにできる。
+ * 推定値はサンプリングした数に間隔を掛けたもの。
+ */
+class SlotAllocationSampler {
+public:
+    /** 記録していないスロットを表す作成位置の番号 */
+    static constexpr uint32_t NO_SITE = UINT32_MAX;
+
+    /// @param interval 何回の作成ごとに1回記録するか（1以上）
+    explicit SlotAllocationSampler(uint32_t interval)
+        : m_interval(interval > 0 ? interval : 1)
+        , m_countdown(m_interval)
+    {}
+
+    /// 記録の間隔
+    uint32_t Interval() const { return m_interval; }
+
+    /// 作成のたびに呼び、今回の作成を記録するならtrueを返す
+    bool ShouldSample() {
+        if (--m_countdown != 0) return false;
+        m_countdown = m_interval;
+        return true;
+    }
+
+    /// 指定スロットに作成された要素の作成位置を記録する
+    void Record(uint32_t slotIndex, const SlotCallSite& site) {
+        auto key = std::make_pair(site.file, site.line);
+        auto it = m_siteIndex.find(key);
+        uint32_t id;
+        if (it == m_siteIndex.end()) {
+            id = static_cast<uint32_t>(m_sites.size());
+            m_siteIndex.emplace(key, id);
+            m_sites.push_back({ site, 0, 0 });
+        }
+        else {
+            id = it->second;
+        }
+
+        if (slotIndex >= m_slotSites.size()) {
+            m_slotSites.resize(static_cast<size_t>(slotIndex) + 1, NO_SITE);
+        }
+        m_slotSites[slotIndex] = id;
+        ++m_sites[id].sampledCreates;
+        ++m_sites[id].sampledLive;
+    }
+
+    /// 指定スロットの要素が削除されたことを記録する
+    void Release(uint32_t slotIndex) {
+        if (slotIndex >= m_slotSites.size()) return;
+        const uint32_t id = m_slotSites[slotIndex];
+        if (id == NO_SITE) return;
+        --m_sites[id].sampledLive;
+        m_slotSites[slotIndex] = NO_SITE;
+    }
+
+    /// 全ての要素が削除された（または入れ替わった）ときに生存数を0に戻す
+    void ResetLive() {
+        m_slotSites.clear();
+        for (SlotAllocationSiteStats& stats : m_sites) {
+            stats.sampledLive = 0;
+        }
+    }
+
+    /// 作成位置ごとの集計（記録した順）
+    const std::vector<SlotAllocationSiteStats>& Sites() const { return m_sites; }
+
+    /**
+     * @brief 推定生存数の多い順に作成位置ごとの集計を書き出す
+     *
+     * 例: "  live~3000 (192000 bytes) created~5000  main.cpp:120 LoadLevel"
+     *
+     * @param elementSize 要素1つのバイト数
+     */
+    void Dump(std::ostream& out, size_t elementSize) const {
+        std::vector<const SlotAllocationSiteStats*> sorted;
+        sorted.reserve(m_sites.size());
+        for (const SlotAllocationSiteStats& stats : m_sites) {
+            sorted.push_back(&stats);
+        }
+        std::stable_sort(sorted.begin(), sorted.end(),
+            [](const SlotAllocationSiteStats* a, const SlotAllocationSiteStats* b) {
+                return a->sampledLive > b->sampledLive;
+            });
+
+        for (const SlotAllocationSiteStats* stats : sorted) {
+            const uint64_t live = stats->sampledLive * m_interval;
+            out << "  live~" << live << " (" << live * elementSize << " bytes)"
+                << " created~" << stats->sampledCreates * m_interval
+                << "  " << stats->site.file << ':' << stats->site.line << ' ' << stats->site.function << '\n';
+        }
+    }
+
+private:
+    /** 記録の間隔 */
+    uint32_t m_interval;
+
+    /** 次に記録するまでの作成数 */
+    uint32_t m_countdown;
+
+    /** 各スロットの要素の作成位置の番号（記録していなければNO_SITE） */
+    std::vector<uint32_t> m_slotSites;
+
+    /** 作成位置ごとの集計 */
+    std::vector<SlotAllocationSiteStats> m_sites;
+
+    /** (ファイル名, 行番号) → 作成位置の番号 */
+    std::map<std::pair<const char*, uint32_t>, uint32_t> m_siteIndex;
+};
\ No newline at end of file
@@ -1,11 +1,18 @@
 #pragma once
 
 #include "SlotHandle.h"
+#include "SlotPoolRegistry.h"
+#include "SlotMemoryBudget.h"
+#include "BackgroundDestructor.h"
 #include <vector>
-#include <queue>
+#include <memory>
+#include <deque>
 #include <cassert>
 #include <functional>
 
+// 前方宣言
+class SlotCycleVisitor;
+
 /**
  * @brief 非テンプレートのプール制御基底クラス
  *
@@ -18,8 +25,18 @@
  * 型依存のデータ（m_data）は派生クラスのObjectSlotSystemBaseが持つ。
  */
 class SlotControlBase {
+    friend class SlotCycleCollector;
+
 public:
-    virtual ~SlotControlBase() = default;
+    /// 診断用のレジストリに登録する
+    SlotControlBase() {
+        SlotPoolRegistry::GetInstance().Register(this);
+    }
+
+    /// 診断用のレジストリから登録を解除する
+    virtual ~SlotControlBase() {
+        SlotPoolRegistry::GetInstance().Unregister(this);
+    }
 
     /// ハンドルが有効かどうかを検証
     bool IsValidHandle(SlotHandle handle) const {
@@ -51,6 +68,9 @@ public:
     /// 有効な要素数を取得
     size_t Count() const { return m_count; }
 
+    /// これまでの生存要素数のピーク
+    size_t PeakCount() const { return m_peakCount; }
+
     /// プールの総容量を取得（削除済み含む）
     size_t Capacity() const { return m_alive.size(); }
 
@@ -60,15 +80,134 @@ public:
     /// 最大容量を取得
     size_t GetMaxCapacity() const { return m_maxCapacity; }
 
-    /// 新しい要素を追加可能か判定
+    /// 新しい要素を追加可能か判定（最大容量のみ。メモリ予算はPrepareCreate()で評価する）
     bool CanCreate() const {
         if (m_maxCapacity == 0) return true;
         return m_count < m_maxCapacity;
     }
 
+    /**
+     * @brief 使用中のメモリ量（バイト）
+     *
+     * 管理情報（世代番号・生存フラグ・参照カウント・空きリスト等）の確保済み容量を含む。
+     * 派生クラスは要素配列のコミット済み領域と購読リストなどを加える。
+     * std::functionなどが別に確保するヒープ領域は含まない概算値。
+     */
+    virtual size_t MemoryUsageBytes() const {
+        return m_generations.capacity() * sizeof(uint32_t)
+            + m_alive.capacity() / 8
+            + m_refCounts.capacity() * sizeof(uint32_t)
+            + m_freeList.size() * sizeof(uint32_t)
+            + m_cycleRoots.capacity() * sizeof(SlotHandle)
+            + m_cycleRootBuffered.capacity() / 8;
+    }
+
+    /// 全てのプールの使用中のメモリ量の合計（バイト）
+    static size_t TotalMemoryUsageBytes() {
+        size_t total = 0;
+        SlotPoolRegistry::GetInstance().ForEachPool([&total](SlotControlBase& pool) {
+            total += pool.MemoryUsageBytes();
+        });
+        return total;
+    }
+
+    /**
+     * @brief このプールのメモリ予算を設定する
+     *
+     * MemoryUsageBytes()で評価する。詳細はSlotMemoryBudgetを参照。
+     *
+     * @param softBytes ソフト閾値（0で無効）
+     * @param hardBytes ハード閾値（0で無効）
+     * @param callback 閾値を超えたときのコールバック
+     */
+    void SetMemoryBudget(size_t softBytes, size_t hardBytes, SlotBudgetCallback callback) {
+        if (softBytes == 0 && hardBytes == 0) {
+            m_memoryBudget.reset();
+            return;
+        }
+        m_memoryBudget = std::make_unique<SlotMemoryBudget>();
+        m_memoryBudget->softBytes = softBytes;
+        m_memoryBudget->hardBytes = hardBytes;
+        m_memoryBudget->callback = std::move(callback);
+    }
+
+    /// このプールのメモリ予算を解除する
+    void ClearMemoryBudget() { m_memoryBudget.reset(); }
+
+    /// 設定中のメモリ予算（設定されていなければnullptr）
+    const SlotMemoryBudget* GetMemoryBudget() const { return m_memoryBudget.get(); }
+
+    /**
+     * @brief メモリ予算を評価する
+     *
+     * プールごとの予算、全体の予算の順に評価し、閾値を超えていればコールバックを呼ぶ。
+     * PrepareCreate()から呼ばれるほか、購読の追加などで使用量が増えた後に明示的に呼んでもよい。
+     *
+     * @return いずれのハード閾値も超えていなければtrue
+     */
+    bool CheckMemoryBudget() {
+        if (m_memoryBudget != nullptr) {
+            if (!m_memoryBudget->Enforce(this, false, [this]() { return MemoryUsageBytes(); })) {
+                return false;
+            }
+        }
+        if (SlotGlobalMemoryBudget::IsActive()) {
+            SlotMemoryBudget& global = SlotGlobalMemoryBudget::GetInstance().Budget();
+            if (!global.Enforce(this, true, []() { return TotalMemoryUsageBytes(); })) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     /// 生ポインタからスロットインデックスを取得（派生クラスで実装）
     virtual uint32_t IndexFromRawPtr(void* rawPtr) const = 0;
 
+    /// 診断出力用のプール名を取得（ObjectSlotSystemBaseで実装）
+    virtual const char* PoolTypeName() const {
+        return "unknown";
+    }
+
+    /// 実行をまたいで同じプールを識別するための型名（ObjectSlotSystemBaseで実装）
+    /// 識別できないプールではnullptr
+    virtual const char* PoolTypeKey() const {
+        return nullptr;
+    }
+
+    /// これまでのコミット済みバイト数のピーク（ObjectSlotSystemBaseで実装）
+    virtual size_t PeakCommittedBytes() const {
+        return 0;
+    }
+
+    /// 未使用の領域を返却し、減ったバイト数を返す（ObjectSlotSystemBaseで実装）
+    /// メモリ逼迫時の応答（MemoryPressureWatcher）から呼ばれる
+    virtual size_t ReleaseUnusedMemory() {
+        return 0;
+    }
+
+    /// 予約プロファイルに従って容量を確保し、要求どおりに確保できたかを返す（ObjectSlotSystemBaseで実装）
+    virtual bool ApplyReservation(size_t count, bool prefault) {
+        (void)count;
+        (void)prefault;
+        return false;
+    }
+
+    /// ページごとの占有状況を集計する（ObjectSlotSystemBaseで実装）
+    /// 対応していないプールでは何も追加しない
+    virtual void CollectOccupancy(std::vector<SlotPageOccupancy>& pages) const {
+        (void)pages;
+    }
+
+    /// 指定スロットの要素が持つSlotPtrを列挙する（ObjectSlotSystemBaseで実装）
+    /// Trace()を持たない型では何もしない
+    virtual void TraceSlotReferences(uint32_t index, SlotCycleVisitor& visitor) {
+        (void)index;
+        (void)visitor;
+    }
+
+    /// 循環参照の回収の候補を記録しているか
+    bool IsCycleCollecting() const { return m_cycleCollecting; }
+
     /// SlotRefのポインタ更新用の登録（RefSlotSystemBaseで実装）
     virtual void RegisterRef(void** ptrLocation, uint32_t slotIndex) {
         (void)ptrLocation;
@@ -124,6 +263,7 @@ public:
 
     /// インデックス指定で参照カウントを増加（SlotRef用）
     void AddRefByIndex(uint32_t index) {
+        BackgroundDestructionThread::CheckNotCurrent();
         if (index < m_alive.size() && m_alive[index]) {
             ++m_refCounts[index];
         }
@@ -131,6 +271,7 @@ public:
 
     /// インデックス指定で参照カウントを減少（SlotRef用）
     void ReleaseRefByIndex(uint32_t index) {
+        BackgroundDestructionThread::CheckNotCurrent();
         if (index < m_alive.size() && m_alive[index]) {
             assert(m_refCounts[index] > 0);
             --m_refCounts[index];
@@ -139,6 +280,9 @@ public:
                 SlotHandle handle{ index, m_generations[index] };
                 RemoveInternal(handle);
             }
+            else if (m_cycleCollecting) {
+                AddCycleRoot(index);
+            }
         }
     }
 
@@ -148,8 +292,23 @@ public:
     }
 
 protected:
+    /**
+     * @brief 要素を作成する直前の判定
+     *
+     * CanCreate()に加え、新しいスロットを末尾に追加する場合はメモリ予算
+     * （プールごとの予算と全体の予算）を評価する。閾値を超えていればコールバックを呼ぶため、
+     * コールバックによる縮小などの副作用がある。
+     */
+    bool PrepareCreate() {
+        if (!CanCreate()) return false;
+        if (!m_freeList.empty()) return true;
+        if (m_memoryBudget == nullptr && !SlotGlobalMemoryBudget::IsActive()) return true;
+        return CheckMemoryBudget();
+    }
+
     /// ハンドル指定で参照カウントを増加
     void AddRef(SlotHandle handle) {
+        BackgroundDestructionThread::CheckNotCurrent();
         if (IsValidHandle(handle)) {
             ++m_refCounts[handle.index];
         }
@@ -157,6 +316,7 @@ protected:
 
     /// ハンドル指定で参照カウントを減少
     void ReleaseRef(SlotHandle handle) {
+        BackgroundDestructionThread::CheckNotCurrent();
         if (IsValidHandle(handle)) {
             assert(m_refCounts[handle.index] > 0);
             --m_refCounts[handle.index];
@@ -164,12 +324,66 @@ protected:
             if (m_refCounts[handle.index] == 0) {
                 RemoveInternal(handle);
             }
+            else if (m_cycleCollecting) {
+                AddCycleRoot(handle.index);
+            }
         }
     }
 
     /// 要素を削除する内部処理（派生クラスで実装）
     virtual void RemoveInternal(SlotHandle handle) = 0;
 
+    /// 削除時にスロットの世代番号を進める（発行済みの最大世代番号も更新）
+    void AdvanceGeneration(uint32_t index) {
+        uint32_t generation = ++m_generations[index];
+        if (generation > m_maxGeneration) {
+            m_maxGeneration = generation;
+        }
+    }
+
+    /// 末尾に追加する新しいスロットの世代番号を取得
+    uint32_t InitialGeneration() const { return m_generationFloor; }
+
+    /**
+     * @brief プール全体の世代（エポック）を進める
+     *
+     * 以降に追加されるスロットの世代番号を、これまでに発行した全ての世代番号より大きくする。
+     * 世代番号の配列を切り詰めても、古いハンドルが同じインデックスの新しい要素と
+     * 一致することはなくなる。有効なハンドルの検証コストは変わらない。
+     */
+    void AdvanceEpoch() {
+        m_generationFloor = m_maxGeneration + 1;
+        m_maxGeneration = m_generationFloor;
+    }
+
+    /**
+     * @brief 参照カウントが0以外に減ったスロットを循環参照の候補として記録する
+     *
+     * 循環の一部だけが外から参照されなくなった時点で、残りの参照は循環内部のものだけの可能性がある。
+     * 同じスロットは回収器が取り出すまで1回だけ記録する。
+     */
+    void AddCycleRoot(uint32_t index) {
+        if (index >= m_cycleRootBuffered.size()) {
+            m_cycleRootBuffered.resize(m_alive.size(), false);
+        }
+        if (m_cycleRootBuffered[index]) return;
+        m_cycleRootBuffered[index] = true;
+        m_cycleRoots.push_back({ index, m_generations[index] });
+    }
+
+    /// 記録した循環参照の候補を全て破棄する
+    void ClearCycleRoots() {
+        m_cycleRoots.clear();
+        m_cycleRootBuffered.clear();
+    }
+
+    /// 外部から復元した世代番号を発行済みの最大世代番号に反映する
+    void NoteGeneration(uint32_t generation) {
+        if (generation > m_maxGeneration) {
+            m_maxGeneration = generation;
+        }
+    }
+
     /** 各スロットの世代番号 */
     std::vector<uint32_t> m_generations;
 
@@ -179,12 +393,33 @@ protected:
     /** 各スロットの参照カウント */
     std::vector<uint32_t> m_refCounts;
 
-    /** 再利用可能なスロットのインデックス */
-    std::queue<uint32_t> m_freeList;
+    /** 再利用可能なスロットのインデックス（先頭から取り出し、末尾に戻す） */
+    std::deque<uint32_t> m_freeList;
 
     /** 有効な要素数 */
     size_t m_count = 0;
 
     /** 最大容量 (0は無制限) */
     size_t m_maxCapacity = 0;
+
+    /** このプールのメモリ予算（設定されていなければnullptr） */
+    std::unique_ptr<SlotMemoryBudget> m_memoryBudget;
+
+    /** 生存要素数のピーク */
+    size_t m_peakCount = 0;
+
+    /** 新しく追加するスロットの世代番号（AdvanceEpochで進む） */
+    uint32_t m_generationFloor = 0;
+
+    /** これまでに発行した最大の世代番号 */
+    uint32_t m_maxGeneration = 0;
+
+    /** 循環参照の回収の候補を記録するかどうか */
+    bool m_cycleCollecting = false;
+
+    /** 循環参照の候補（参照カウントが0以外に減ったスロット） */
+    std::vector<SlotHandle> m_cycleRoots;
+
+    /** 各スロットが候補として記録済みかどうか */
+    std::vector<bool> m_cycleRootBuffered;
 };
\ No newline at end of file
@@ -0,0 +1,368 @@
+#pragma once
+
+#include "SlotControlBase.h"
+#include "SlotCycleVisitor.h"
+#include "SlotPoolRegistry.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 参照カウントで解放できない循環参照の回収器
+ *
+ * SlotPtrが互いを所有し合う循環は、外から参照されなくなっても参照カウントが0にならず、
+ * 解放されないまま残る。回収器は試し削除（Bacon–Rajanの同期型アルゴリズム）で
+ * そのような循環を見つけて解放する。
+ *
+ * 1. 候補: SetCycleCollection(true)にしたプールで、参照カウントが0以外に減った要素
+ * 2. 候補から到達できる要素の参照カウントの写しから、内部の参照（Traceで列挙したSlotPtr）の分を引く
+ * 3. 写しが0より大きい要素（外から参照されている）と、そこから到達できる要素を生存とする
+ * 4. 残った要素は循環の内部からしか参照されていないので、内部の参照を切ってから解放する
+ *
+ * 候補は一定数ずつ処理し、Collect()に渡した時間を超えたら次の呼び出しに残す。
+ * フレームの空き時間などに少しずつ呼び出せる。
+ *
+ * 使用例:
+ * @code
+ *   ObjectSlotSystem<Node>::GetInstance().SetCycleCollection(true);
+ *   // ... 毎フレーム ...
+ *   SlotCycleCollector::GetInstance().Collect(std::chrono::microseconds(200));
+ * @endcode
+ *
+ * 注意事項:
+ * - 回収中に要素のデストラクタが実行されるため、プールの操作中（デストラクタや購読者の通知の中）から呼ばないこと
+ * - スレッドセーフではない。プールを操作するスレッドから呼ぶこと
+ */
+class SlotCycleCollector {
+public:
+    /** 1回の試し削除で処理する候補の最大数 */
+    static constexpr size_t ROOTS_PER_ROUND = 256;
+
+    /// シングルトンインスタンスを取得
+    static SlotCycleCollector& GetInstance() {
+        static SlotCycleCollector instance;
+        return instance;
+    }
+
+    /**
+     * @brief 循環参照を回収する
+     *
+     * 候補をROOTS_PER_ROUND個ずつ試し削除し、budgetを超えた時点で打ち切る。
+     * budgetが0でも最低1回は処理する。
+     *
+     * @param budget この呼び出しで使ってよい時間
+     * @return 解放した要素の数
+     */
+    size_t Collect(std::chrono::nanoseconds budget) {
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<SlotControlBase*> pools;
+        SlotPoolRegistry::GetInstance().ForEachPool([&pools](SlotControlBase& pool) {
+            if (pool.m_cycleCollecting || !pool.m_cycleRoots.empty()) {
+                pools.push_back(&pool);
+            }
+        });
+
+        size_t collected = 0;
+        std::vector<RootEntry> roots;
+        while (true) {
+            roots.clear();
+            for (SlotControlBase* pool : pools) {
+                while (roots.size() < ROOTS_PER_ROUND && !pool->m_cycleRoots.empty()) {
+                    SlotHandle handle = pool->m_cycleRoots.back();
+                    pool->m_cycleRoots.pop_back();
+                    // 削除済みの要素の候補は捨てる（再利用後の要素の候補フラグは消さない）
+                    if (!pool->IsValidHandle(handle)) continue;
+                    if (handle.index < pool->m_cycleRootBuffered.size()) {
+                        pool->m_cycleRootBuffered[handle.index] = false;
+                    }
+                    roots.push_back({ pool, handle });
+                }
+            }
+            if (roots.empty()) break;
+
+            collected += RunRound(roots, pools);
+            if (std::chrono::steady_clock::now() - start >= budget) break;
+        }
+
+        m_totalCollected += collected;
+        return collected;
+    }
+
+    /// 時間制限なしで全ての候補を処理する
+    size_t CollectAll() {
+        return Collect(std::chrono::nanoseconds::max());
+    }
+
+    /// 処理を待っている候補の数
+    size_t PendingRoots() const {
+        size_t pending = 0;
+        SlotPoolRegistry::GetInstance().ForEachPool([&pending](SlotControlBase& pool) {
+            pending += pool.m_cycleRoots.size();
+        });
+        return pending;
+    }
+
+    /// これまでに解放した要素の総数
+    uint64_t TotalCollected() const { return m_totalCollected; }
+
+    // コピー・ムーブ禁止
+    SlotCycleCollector(const SlotCycleCollector&) = delete;
+    SlotCycleCollector& operator=(const SlotCycleCollector&) = delete;
+    SlotCycleCollector(SlotCycleCollector&&) = delete;
+    SlotCycleCollector& operator=(SlotCycleCollector&&) = delete;
+
+private:
+    SlotCycleCollector() = default;
+    ~SlotCycleCollector() = default;
+
+    /// 試し削除中の要素の色
+    enum class Color : uint8_t {
+        Black,  ///< 生存（外から到達できる）
+        Gray,   ///< 内部の参照を引いている途中
+        White   ///< 循環の内部からしか参照されていない
+    };
+
+    /// 候補1件
+    struct RootEntry {
+        SlotControlBase* pool;
+        SlotHandle handle;
+    };
+
+    /// 試し削除中の要素1件
+    struct Node {
+        SlotControlBase* pool = nullptr;
+        uint32_t index = 0;
+        Color color = Color::Black;
+        bool traced = false;
+
+        /** 参照カウントの写し */
+        int64_t refCount = 0;
+
+        /** m_edges内の子の範囲 */
+        size_t childBegin = 0;
+        size_t childEnd = 0;
+    };
+
+    /// 要素の識別子（プールとスロットインデックスの組）
+    struct NodeKey {
+        SlotControlBase* pool;
+        uint32_t index;
+
+        bool operator==(const NodeKey& other) const {
+            return pool == other.pool && index == other.index;
+        }
+    };
+
+    struct NodeKeyHash {
+        size_t operator()(const NodeKey& key) const {
+            return std::hash<const void*>()(key.pool) ^ (static_cast<size_t>(key.index) * 0x9E3779B97F4A7C15ull);
+        }
+    };
+
+    /// 参照を列挙してキーを集めるビジター
+    class EdgeVisitor : public SlotCycleVisitor {
+    public:
+        explicit EdgeVisitor(std::vector<NodeKey>& keys) : m_keys(keys) {}
+
+    protected:
+        bool OnReference(SlotControlBase& pool, uint32_t index) override {
+            m_keys.push_back({ &pool, index });
+            return false;
+        }
+
+    private:
+        std::vector<NodeKey>& m_keys;
+    };
+
+    /// 回収対象（白）への参照を切るビジター
+    class CutVisitor : public SlotCycleVisitor {
+    public:
+        explicit CutVisitor(const SlotCycleCollector& collector) : m_collector(collector) {}
+
+    protected:
+        bool OnReference(SlotControlBase& pool, uint32_t index) override {
+            auto it = m_collector.m_nodeIds.find({ &pool, index });
+            return it != m_collector.m_nodeIds.end() && m_collector.m_nodes[it->second].color == Color::White;
+        }
+
+    private:
+        const SlotCycleCollector& m_collector;
+    };
+
+    /**
+     * @brief 候補の集まりに対して試し削除を1回行う
+     *
+     * @return 解放した要素の数
+     */
+    size_t RunRound(const std::vector<RootEntry>& roots, const std::vector<SlotControlBase*>& pools) {
+        m_nodes.clear();
+        m_nodeIds.clear();
+        m_edges.clear();
+
+        std::vector<uint32_t> rootIds;
+        for (const RootEntry& root : roots) {
+            if (root.pool->IsValidHandle(root.handle) && root.pool->GetRefCount(root.handle) > 0) {
+                rootIds.push_back(GetNode(root.pool, root.handle.index));
+            }
+        }
+
+        for (uint32_t id : rootIds) {
+            MarkGray(id);
+        }
+        for (uint32_t id : rootIds) {
+            Scan(id);
+        }
+
+        std::vector<RootEntry> garbage;
+        for (const Node& node : m_nodes) {
+            if (node.color == Color::White) {
+                garbage.push_back({ node.pool, node.pool->HandleFromIndex(node.index) });
+            }
+        }
+        if (garbage.empty()) return 0;
+
+        // 解放の途中で消えないよう全ての白を保持してから、白同士の参照を切る
+        for (const RootEntry& entry : garbage) {
+            entry.pool->AddRefByIndex(entry.handle.index);
+        }
+
+        // 参照を切る際の減算は候補として記録しない
+        std::vector<bool> collecting;
+        for (SlotControlBase* pool : pools) {
+            collecting.push_back(pool->m_cycleCollecting);
+            pool->m_cycleCollecting = false;
+        }
+        CutVisitor cut(*this);
+        for (const RootEntry& entry : garbage) {
+            entry.pool->TraceSlotReferences(entry.handle.index, cut);
+        }
+        for (size_t i = 0; i < pools.size(); ++i) {
+            pools[i]->m_cycleCollecting = collecting[i];
+        }
+
+        // 保持を解除すると参照カウントが0になり、通常の削除処理で解放される
+        for (const RootEntry& entry : garbage) {
+            entry.pool->ReleaseRefByIndex(entry.handle.index);
+        }
+
+        size_t collected = 0;
+        for (const RootEntry& entry : garbage) {
+            if (!entry.pool->IsValidHandle(entry.handle)) {
+                ++collected;
+            }
+        }
+        return collected;
+    }
+
+    /// 要素に対応するノードを取得（初出なら参照カウントの写しを取って追加）
+    uint32_t GetNode(SlotControlBase* pool, uint32_t index) {
+        auto result = m_nodeIds.emplace(NodeKey{ pool, index }, static_cast<uint32_t>(m_nodes.size()));
+        if (result.second) {
+            Node node;
+            node.pool = pool;
+            node.index = index;
+            node.refCount = pool->GetRefCountByIndex(index);
+            m_nodes.push_back(node);
+        }
+        return result.first->second;
+    }
+
+    /// ノードの子（要素が持つSlotPtrの参照先）を列挙してm_edgesに記録する
+    void TraceNode(uint32_t id) {
+        if (m_nodes[id].traced) return;
+        m_nodes[id].traced = true;
+
+        m_keys.clear();
+        EdgeVisitor visitor(m_keys);
+        m_nodes[id].pool->TraceSlotReferences(m_nodes[id].index, visitor);
+
+        const size_t begin = m_edges.size();
+        for (const NodeKey& key : m_keys) {
+            m_edges.push_back(GetNode(key.pool, key.index));
+        }
+        m_nodes[id].childBegin = begin;
+        m_nodes[id].childEnd = m_edges.size();
+    }
+
+    /// 候補から到達できる要素を灰色にし、内部の参照の分だけ参照カウントの写しを減らす
+    void MarkGray(uint32_t root) {
+        if (m_nodes[root].color == Color::Gray) return;
+        m_nodes[root].color = Color::Gray;
+        m_stack.assign(1, root);
+
+        while (!m_stack.empty()) {
+            uint32_t id = m_stack.back();
+            m_stack.pop_back();
+            TraceNode(id);
+            for (size_t e = m_nodes[id].childBegin; e < m_nodes[id].childEnd; ++e) {
+                Node& child = m_nodes[m_edges[e]];
+                --child.refCount;
+                if (child.color != Color::Gray) {
+                    child.color = Color::Gray;
+                    m_stack.push_back(m_edges[e]);
+                }
+            }
+        }
+    }
+
+    /// 灰色の要素を、外から参照されていれば黒（生存）、そうでなければ白に分ける
+    void Scan(uint32_t root) {
+        m_stack.assign(1, root);
+        while (!m_stack.empty()) {
+            uint32_t id = m_stack.back();
+            m_stack.pop_back();
+            if (m_nodes[id].color != Color::Gray) continue;
+
+            if (m_nodes[id].refCount > 0) {
+                ScanBlack(id);
+            }
+            else {
+                m_nodes[id].color = Color::White;
+                for (size_t e = m_nodes[id].childBegin; e < m_nodes[id].childEnd; ++e) {
+                    m_stack.push_back(m_edges[e]);
+                }
+            }
+        }
+    }
+
+    /// 生存している要素から到達できる要素を黒に戻し、引いた参照カウントを元に戻す
+    void ScanBlack(uint32_t root) {
+        m_nodes[root].color = Color::Black;
+        std::vector<uint32_t> stack(1, root);
+
+        while (!stack.empty()) {
+            uint32_t id = stack.back();
+            stack.pop_back();
+            for (size_t e = m_nodes[id].childBegin; e < m_nodes[id].childEnd; ++e) {
+                Node& child = m_nodes[m_edges[e]];
+                ++child.refCount;
+                if (child.color != Color::Black) {
+                    child.color = Color::Black;
+                    stack.push_back(m_edges[e]);
+                }
+            }
+        }
+    }
+
+    /** 試し削除中の要素 */
+    std::vector<Node> m_nodes;
+
+    /** 要素の識別子からm_nodesのインデックスへの対応 */
+    std::unordered_map<NodeKey, uint32_t, NodeKeyHash> m_nodeIds;
+
+    /** 全ノードの子（m_nodesのインデックス）を連結した配列 */
+    std::vector<uint32_t> m_edges;
+
+    /** 子の列挙に使う作業領域 */
+    std::vector<NodeKey> m_keys;
+
+    /** 走査に使う作業領域 */
+    std::vector<uint32_t> m_stack;
+
+    /** これまでに解放した要素の総数 */
+    uint64_t m_totalCollected = 0;
+};
\ No newline at end of file
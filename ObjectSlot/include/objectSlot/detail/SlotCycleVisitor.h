@@ -0,0 +1,75 @@
+#pragma once
+
+#include "SlotHandle.h"
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// 前方宣言
+class SlotControlBase;
+
+template<typename T>
+class SlotPtr;
+
+/**
+ * @brief 要素が持つSlotPtrを循環参照の回収器に列挙させるビジター
+ *
+ * 循環参照の回収（SlotCycleCollector）に参加する型は、次の形のメンバ関数を持つ:
+ * @code
+ *   struct Node {
+ *       SlotPtr<Node> next;
+ *       std::vector<SlotPtr<Node>> children;
+ *       template<class Visitor>
+ *       void Trace(Visitor& visitor) { visitor(next, children); }
+ *   };
+ * @endcode
+ *
+ * 列挙するのは強参照（SlotPtr）だけでよい。WeakSlotPtrは参照カウントに含まれないため不要。
+ * 列挙漏れがあっても回収されないだけで、誤って解放されることはない。
+ */
+class SlotCycleVisitor {
+public:
+    /// 複数のSlotPtr（またはそのvector）をまとめて列挙する
+    template<typename... Ptrs>
+    void operator()(Ptrs&... ptrs) {
+        (Visit(ptrs), ...);
+    }
+
+protected:
+    SlotCycleVisitor() = default;
+    ~SlotCycleVisitor() = default;
+
+    /**
+     * @brief 参照を1つ受け取る（回収器で実装）
+     *
+     * @param pool 参照先のプール
+     * @param index 参照先のスロットインデックス
+     * @return 参照を切る（SlotPtrをリセットする）場合はtrue
+     */
+    virtual bool OnReference(SlotControlBase& pool, uint32_t index) = 0;
+
+private:
+    template<typename U>
+    void Visit(SlotPtr<U>& ptr) {
+        if (!ptr) return;
+        if (OnReference(*ptr.GetControl(), ptr.GetHandle().index)) {
+            ptr.Reset();
+        }
+    }
+
+    template<typename U>
+    void Visit(std::vector<SlotPtr<U>>& ptrs) {
+        for (SlotPtr<U>& ptr : ptrs) {
+            Visit(ptr);
+        }
+    }
+};
+
+/// Trace(SlotCycleVisitor&)を持つ型かどうか
+template<typename T, typename = void>
+struct HasSlotCycleTrace : std::false_type {};
+
+template<typename T>
+struct HasSlotCycleTrace<T,
+    std::void_t<decltype(std::declval<T&>().Trace(std::declval<SlotCycleVisitor&>()))>> : std::true_type {};
\ No newline at end of file
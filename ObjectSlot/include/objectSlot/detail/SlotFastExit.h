@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <type_traits>
+
+/**
+ * @brief プロセス終了時に要素の破棄を省略するかどうかを指定する特性
+ *
+ * std::true_typeを継承させた型のプールは、SlotFastExitの設定に関わらず、
+ * 破棄時に生存している要素のデストラクタを呼ばず、予約したメモリも解放しない。
+ * プールはシングルトンなので、破棄されるのはプロセス終了時だけである。
+ *
+ * 使用例:
+ * @code
+ *   template<>
+ *   struct UseFastExit<Particle> : std::true_type {};
+ * @endcode
+ *
+ * @tparam T 対象の要素の型
+ */
+template<typename T>
+struct UseFastExit : std::false_type {};
+
+/**
+ * @brief プロセス終了時のプールの後片付けを省略する設定
+ *
+ * 有効にすると、以降に破棄される全てのプールが生存要素のデストラクタ呼び出しと
+ * 予約したメモリの解放を省略する。メモリはプロセス終了時にOSがまとめて回収するため、
+ * 大量の要素を持つプロセスの終了時間を短縮できる。
+ *
+ * 外部に副作用を持つデストラクタ（ファイルのフラッシュ等）の要素を持つプールは、
+ * SetFlushOnExit(true)で通常通り破棄させるか、終了前にClear()で明示的に破棄しておくこと。
+ *
+ * 使用例:
+ * @code
+ *   int main() {
+ *       ObjectSlotSystem<LogFile>::GetInstance().SetFlushOnExit(true);
+ *       // ...
+ *       SlotFastExit::SetEnabled(true);
+ *       return 0;
+ *   }
+ * @endcode
+ */
+class SlotFastExit {
+public:
+    /// 高速終了を切り替える
+    static void SetEnabled(bool enabled) {
+        s_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    /// 高速終了が有効かどうか
+    static bool IsEnabled() {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    SlotFastExit() = delete;
+
+private:
+    /** 高速終了が有効かどうか */
+    static inline std::atomic<bool> s_enabled{ false };
+};
\ No newline at end of file
@@ -0,0 +1,693 @@
+#pragma once
+
+#include "SlotControlBase.h"
+#include "SlotPtr.h"
+#include "SignalSlotPtr.h"
+#include "SlotRef.h"
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// 前方宣言
+class SlotGraphWriter;
+class SlotGraphReader;
+
+/**
+ * @brief 型ごとに一意なキーを取得する（シリアライズ時の型の照合用）
+ */
+template<typename T>
+const void* SlotGraphTypeKey() {
+    static const char key = 0;
+    return &key;
+}
+
+/**
+ * @brief ストリーム上のポインタの表現
+ *
+ * 参照先の要素を（プール番号, スロットインデックス）で表す。
+ * byteOffsetは要素の先頭から参照先までのバイト数で、
+ * 基底クラスのサブオブジェクトやエイリアシングで指すメンバを復元するのに使う。
+ */
+struct SlotGraphLink {
+    /** 参照先のプール番号（RegisterPoolの登録順） */
+    uint32_t poolId = UINT32_MAX;
+
+    /** 参照先のスロットインデックス */
+    uint32_t index = 0;
+
+    /** 要素の先頭から参照先までのバイト数 */
+    uint64_t byteOffset = 0;
+
+    /// nullを表すリンクかどうか
+    bool IsNull() const { return poolId == UINT32_MAX; }
+};
+
+/**
+ * @brief SlotGraphWriter/SlotGraphReaderから見たプールの共通インターフェース
+ */
+class SlotGraphPoolBase {
+public:
+    virtual ~SlotGraphPoolBase() = default;
+
+    /// プールの非テンプレート基底を取得
+    virtual SlotControlBase* Control() const = 0;
+
+    /// スロット数（削除済みを含む）を取得
+    virtual uint32_t SlotCount() const = 0;
+
+    /// 指定スロットが生存しているか
+    virtual bool IsAlive(uint32_t index) const = 0;
+
+    /// 要素配列の先頭アドレスを取得
+    virtual unsigned char* DataBegin() const = 0;
+
+    /// 要素1つのバイト数を取得
+    virtual size_t ElementSize() const = 0;
+
+    /// 所有者（SlotPtr/SignalSlotPtr）の型キーを取得
+    virtual const void* OwnerTypeKey() const = 0;
+
+    /// 読み込み中の所有者を取得（OwnerTypeKeyの型として扱う）
+    virtual const void* OwnerAt(uint32_t index) const = 0;
+
+    /// 指定スロットの要素を書き込む
+    virtual void WriteObject(SlotGraphWriter& writer, uint32_t index) = 0;
+
+    /// 指定スロットの要素を読み込む
+    virtual void ReadObject(SlotGraphReader& reader, uint32_t index) = 0;
+
+    /// 読み込みの準備として、スロット数分の仮の要素を作成する
+    virtual bool BeginLoad(uint32_t slotCount) = 0;
+
+    /// 読み込みの後始末として、削除済みだったスロットの仮の要素を解放する
+    virtual void FinishLoad(const std::vector<bool>& alive) = 0;
+
+    /// 読み込みに失敗したときに、作成した仮の要素を全て破棄してプールを空に戻す
+    virtual void AbortLoad() = 0;
+};
+
+/**
+ * @brief プールをシリアライズ用に登録するためのラッパー
+ *
+ * @tparam Pool プールのクラステンプレート（ObjectSlotSystem/SignalSlotSystem/RefSlotSystem）
+ * @tparam T 要素の型
+ */
+template<template<typename> class Pool, typename T>
+class SlotGraphPool : public SlotGraphPoolBase {
+public:
+    /** Create()が返す所有者の型 */
+    using Owner = decltype(std::declval<Pool<T>&>().Create(std::declval<T&&>()));
+
+    explicit SlotGraphPool(Pool<T>& pool)
+        : m_pool(pool)
+    {
+    }
+
+    SlotControlBase* Control() const override { return &m_pool; }
+
+    uint32_t SlotCount() const override {
+        return static_cast<uint32_t>(m_pool.Capacity());
+    }
+
+    bool IsAlive(uint32_t index) const override {
+        return m_pool.IsValidHandle(m_pool.HandleFromIndex(index));
+    }
+
+    unsigned char* DataBegin() const override {
+        return reinterpret_cast<unsigned char*>(m_pool.DataPtr());
+    }
+
+    size_t ElementSize() const override { return sizeof(T); }
+
+    const void* OwnerTypeKey() const override { return SlotGraphTypeKey<Owner>(); }
+
+    const void* OwnerAt(uint32_t index) const override { return &m_owners[index]; }
+
+    void WriteObject(SlotGraphWriter& writer, uint32_t index) override;
+
+    void ReadObject(SlotGraphReader& reader, uint32_t index) override;
+
+    /**
+     * @brief スロット数分の仮の要素を作成する
+     *
+     * 空のプールに順に作成するため、スロットインデックスが書き込み時と一致する。
+     * 要素のアドレスは以降変わらないので、リンクの解決はこの後に行う。
+     */
+    bool BeginLoad(uint32_t slotCount) override {
+        if (m_pool.Count() != 0) return false;
+        m_pool.Clear();
+        m_pool.Reserve(slotCount);
+
+        m_owners.clear();
+        m_owners.reserve(slotCount);
+        for (uint32_t i = 0; i < slotCount; ++i) {
+            Owner owner = m_pool.Create(T{});
+            if (!owner) return false;
+            m_owners.push_back(std::move(owner));
+        }
+        return true;
+    }
+
+    void FinishLoad(const std::vector<bool>& alive) override {
+        for (size_t i = 0; i < m_owners.size(); ++i) {
+            if (!alive[i]) {
+                m_owners[i] = Owner();
+            }
+        }
+    }
+
+    /// 要素同士の参照が残っていても、Clear()で全て破棄する
+    void AbortLoad() override {
+        m_owners.clear();
+        m_pool.Clear();
+    }
+
+    /// 読み込んだ要素の所有者を取り出す（削除済みだったスロットは除く）
+    std::vector<Owner> TakeOwners() {
+        std::vector<Owner> result;
+        for (auto& owner : m_owners) {
+            if (owner) {
+                result.push_back(std::move(owner));
+            }
+        }
+        m_owners.clear();
+        return result;
+    }
+
+private:
+    /** 対象のプール */
+    Pool<T>& m_pool;
+
+    /** 読み込み中の仮の要素の所有者（スロットインデックス順） */
+    std::vector<Owner> m_owners;
+};
+
+/**
+ * @brief シリアライズ可能な型の判定（template<class Archive> void Serialize(Archive&) を持つか）
+ */
+template<typename V, typename Archive, typename = void>
+struct HasSlotGraphSerialize : std::false_type {};
+
+template<typename V, typename Archive>
+struct HasSlotGraphSerialize<V, Archive,
+    std::void_t<decltype(std::declval<V&>().Serialize(std::declval<Archive&>()))>> : std::true_type {};
+
+/**
+ * @brief 複数のプールにまたがるオブジェクトグラフの書き込み
+ *
+ * 登録した全てのプールの生存要素を1つのストリームに書き込む。
+ * 要素間のSlotPtr/SignalSlotPtr/SlotRefは（プール番号, スロットインデックス）に
+ * 置き換えて書き込むため、読み込み時に別のアドレスへ配置されても参照を復元できる。
+ *
+ * 要素の型は次の形のメンバ関数を持つ必要がある:
+ * @code
+ *   template<class Archive>
+ *   void Serialize(Archive& ar) { ar(name, roughness, material, parent); }
+ * @endcode
+ *
+ * arに渡せるのは算術型・列挙型、std::string、std::vector、
+ * SlotPtr/SignalSlotPtr/SlotRef、およびSerializeを持つ型である。
+ *
+ * 参照先のプールが登録されていないポインタがあるとWrite()はfalseを返す。
+ *
+ * 使用例:
+ * @code
+ *   SlotGraphWriter writer(out);
+ *   writer.RegisterPool(ObjectSlotSystem<Material>::GetInstance());
+ *   writer.RegisterPool(ObjectSlotSystem<Node>::GetInstance());
+ *   writer.Write();
+ * @endcode
+ */
+class SlotGraphWriter {
+public:
+    /** ストリーム先頭の識別子（"OSGR"） */
+    static constexpr uint32_t MAGIC = 0x5247534F;
+
+    /** フォーマットのバージョン */
+    static constexpr uint32_t VERSION = 1;
+
+    explicit SlotGraphWriter(std::ostream& out)
+        : m_out(out)
+    {
+    }
+
+    /**
+     * @brief プールを登録する
+     *
+     * 読み込み側でも同じ順序で登録すること。
+     *
+     * @return プール番号
+     */
+    template<template<typename> class Pool, typename T>
+    uint32_t RegisterPool(Pool<T>& pool) {
+        m_pools.push_back(std::make_unique<SlotGraphPool<Pool, T>>(pool));
+        return static_cast<uint32_t>(m_pools.size() - 1);
+    }
+
+    /**
+     * @brief 登録した全てのプールを書き込む
+     *
+     * 全プールのスロット情報を先に書き、その後に要素のデータを書き込む。
+     *
+     * @return 全ての要素とリンクを書き込めた場合はtrue
+     */
+    bool Write() {
+        m_ok = true;
+        WriteRaw(MAGIC);
+        WriteRaw(VERSION);
+        WriteRaw(static_cast<uint32_t>(m_pools.size()));
+
+        for (auto& pool : m_pools) {
+            uint32_t slotCount = pool->SlotCount();
+            WriteRaw(static_cast<uint64_t>(pool->ElementSize()));
+            WriteRaw(slotCount);
+            for (uint32_t i = 0; i < slotCount; ++i) {
+                WriteRaw(static_cast<uint8_t>(pool->IsAlive(i) ? 1 : 0));
+            }
+        }
+
+        for (auto& pool : m_pools) {
+            uint32_t slotCount = pool->SlotCount();
+            for (uint32_t i = 0; i < slotCount; ++i) {
+                if (pool->IsAlive(i)) {
+                    pool->WriteObject(*this, i);
+                }
+            }
+        }
+        return m_ok && m_out.good();
+    }
+
+    /// 要素のSerializeから呼ばれ、各フィールドを順に書き込む
+    template<typename... Args>
+    void operator()(const Args&... args) {
+        (Process(args), ...);
+    }
+
+private:
+    template<typename V>
+    void WriteRaw(const V& value) {
+        m_out.write(reinterpret_cast<const char*>(&value), sizeof(V));
+    }
+
+    template<typename V>
+    void Process(const V& value) {
+        if constexpr (std::is_arithmetic_v<V> || std::is_enum_v<V>) {
+            WriteRaw(value);
+        }
+        else {
+            static_assert(HasSlotGraphSerialize<V, SlotGraphWriter>::value,
+                "SlotGraphWriterで書き込めない型です。Serializeを実装してください。");
+            const_cast<V&>(value).Serialize(*this);
+        }
+    }
+
+    void Process(const std::string& value) {
+        WriteRaw(static_cast<uint64_t>(value.size()));
+        m_out.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+    template<typename U>
+    void Process(const std::vector<U>& values) {
+        static_assert(!std::is_same_v<U, bool>, "std::vector<bool>は未対応です。");
+        WriteRaw(static_cast<uint64_t>(values.size()));
+        for (const U& value : values) {
+            Process(value);
+        }
+    }
+
+    template<typename U>
+    void Process(const SlotPtr<U>& ptr) {
+        WriteLink(ptr ? ptr.GetControl() : nullptr, ptr ? ptr.Get() : nullptr);
+    }
+
+    template<typename U>
+    void Process(const SignalSlotPtr<U>& ptr) {
+        WriteLink(ptr ? ptr.GetControl() : nullptr, ptr ? ptr.Get() : nullptr);
+    }
+
+    template<typename U>
+    void Process(const SlotRef<U>& ref) {
+        WriteLink(ref.GetControl(), ref.Get());
+    }
+
+    /**
+     * @brief ポインタをリンクに置き換えて書き込む
+     *
+     * 要素配列の先頭からのバイト数を要素サイズで割り、
+     * 商をスロットインデックス、余りを要素内のオフセットとする。
+     */
+    void WriteLink(SlotControlBase* control, const void* target) {
+        SlotGraphLink link;
+        if (control != nullptr && target != nullptr) {
+            for (uint32_t id = 0; id < m_pools.size(); ++id) {
+                if (m_pools[id]->Control() != control) continue;
+
+                const auto* bytes = static_cast<const unsigned char*>(target);
+                size_t offset = static_cast<size_t>(bytes - m_pools[id]->DataBegin());
+                link.poolId = id;
+                link.index = static_cast<uint32_t>(offset / m_pools[id]->ElementSize());
+                link.byteOffset = offset % m_pools[id]->ElementSize();
+                break;
+            }
+            // 登録されていないプールを指している
+            if (link.IsNull()) {
+                m_ok = false;
+            }
+        }
+        WriteRaw(link.poolId);
+        WriteRaw(link.index);
+        WriteRaw(link.byteOffset);
+    }
+
+    /** 書き込み先 */
+    std::ostream& m_out;
+
+    /** 登録されたプール */
+    std::vector<std::unique_ptr<SlotGraphPoolBase>> m_pools;
+
+    /** 書き込み中にエラーがなかったか */
+    bool m_ok = true;
+};
+
+/**
+ * @brief SlotGraphWriterで書き込んだオブジェクトグラフの読み込み
+ *
+ * 書き込み時と同じ順序でプールを登録してからRead()を呼ぶ。
+ * 各プールは空である必要があり、要素は書き込み時と同じスロットインデックスに配置される。
+ * 世代番号は引き継がれないため、書き込み前のSlotHandleは読み込み後には使えない。
+ *
+ * 読み込みは2段階で行う:
+ * 1. 全プールにスロット数分の仮の要素（デフォルト構築）を作成し、全要素のアドレスを確定する
+ * 2. 各要素のSerializeでフィールドを読み込み、リンクを参照先の所有者から復元する
+ *
+ * 要素の型はデフォルト構築可能である必要がある。
+ * スロット数や文字列・配列の長さはストリームの残りのバイト数で検証し、
+ * 壊れたデータで巨大な確保をしない。途中で失敗した場合は、作成した要素を全て破棄して
+ * 登録した全てのプールを空に戻す。
+ * 読み込んだ要素の所有権はTakeObjects()で取り出す。取り出さなかった要素は
+ * グラフ内の他の要素から参照されていなければ、Readerの破棄時に解放される。
+ *
+ * 使用例:
+ * @code
+ *   SlotGraphReader reader(in);
+ *   reader.RegisterPool(ObjectSlotSystem<Material>::GetInstance());
+ *   reader.RegisterPool(ObjectSlotSystem<Node>::GetInstance());
+ *   if (reader.Read()) {
+ *       auto nodes = reader.TakeObjects(ObjectSlotSystem<Node>::GetInstance());
+ *   }
+ * @endcode
+ */
+class SlotGraphReader {
+public:
+    explicit SlotGraphReader(std::istream& in)
+        : m_in(in)
+    {
+    }
+
+    /**
+     * @brief プールを登録する（書き込み時と同じ順序）
+     *
+     * @return プール番号
+     */
+    template<template<typename> class Pool, typename T>
+    uint32_t RegisterPool(Pool<T>& pool) {
+        m_pools.push_back(std::make_unique<SlotGraphPool<Pool, T>>(pool));
+        return static_cast<uint32_t>(m_pools.size() - 1);
+    }
+
+    /**
+     * @brief ストリームからグラフを読み込む
+     *
+     * @return 形式が正しく、全てのリンクを復元できた場合はtrue。falseの場合、登録した全てのプールは空になる
+     */
+    bool Read() {
+        m_ok = true;
+        m_consumed = 0;
+        m_streamBytes = StreamRemaining();
+        uint32_t magic = 0, version = 0, poolCount = 0;
+        ReadRaw(magic);
+        ReadRaw(version);
+        ReadRaw(poolCount);
+        if (!m_in.good() || magic != SlotGraphWriter::MAGIC || version != SlotGraphWriter::VERSION) return false;
+        if (poolCount != m_pools.size()) return false;
+
+        m_alive.assign(m_pools.size(), std::vector<bool>());
+        for (size_t id = 0; id < m_pools.size(); ++id) {
+            uint64_t elementSize = 0;
+            uint32_t slotCount = 0;
+            ReadRaw(elementSize);
+            ReadRaw(slotCount);
+            if (!m_in.good() || elementSize != m_pools[id]->ElementSize()) return false;
+            if (!FitsInStream(slotCount)) return false;
+
+            m_alive[id].resize(slotCount);
+            for (uint32_t i = 0; i < slotCount; ++i) {
+                uint8_t alive = 0;
+                ReadRaw(alive);
+                m_alive[id][i] = alive != 0;
+            }
+        }
+        if (!m_in.good()) return false;
+        for (auto& pool : m_pools) {
+            if (pool->Control()->Count() != 0) return false;
+        }
+
+        // 全要素のアドレスを確定させてからリンクを解決する
+        for (size_t id = 0; id < m_pools.size() && m_ok; ++id) {
+            m_ok = m_pools[id]->BeginLoad(static_cast<uint32_t>(m_alive[id].size()));
+        }
+
+        for (size_t id = 0; id < m_pools.size() && m_ok; ++id) {
+            for (uint32_t i = 0; i < m_alive[id].size() && m_ok; ++i) {
+                if (m_alive[id][i]) {
+                    m_pools[id]->ReadObject(*this, i);
+                }
+            }
+        }
+
+        if (!m_ok || !m_in.good()) {
+            for (auto& pool : m_pools) {
+                pool->AbortLoad();
+            }
+            return false;
+        }
+
+        for (size_t id = 0; id < m_pools.size(); ++id) {
+            m_pools[id]->FinishLoad(m_alive[id]);
+        }
+        return true;
+    }
+
+    /**
+     * @brief 読み込んだ要素の所有者を取り出す
+     *
+     * @return スロットインデックス順の所有者（SlotPtr/SignalSlotPtr）
+     */
+    template<template<typename> class Pool, typename T>
+    auto TakeObjects(Pool<T>& pool) {
+        for (auto& entry : m_pools) {
+            if (entry->Control() == &pool) {
+                return static_cast<SlotGraphPool<Pool, T>&>(*entry).TakeOwners();
+            }
+        }
+        return std::vector<typename SlotGraphPool<Pool, T>::Owner>();
+    }
+
+    /// 要素のSerializeから呼ばれ、各フィールドを順に読み込む
+    template<typename... Args>
+    void operator()(Args&... args) {
+        (Process(args), ...);
+    }
+
+private:
+    template<typename V>
+    void ReadRaw(V& value) {
+        m_in.read(reinterpret_cast<char*>(&value), sizeof(V));
+        m_consumed += static_cast<uint64_t>(m_in.gcount());
+    }
+
+    /// 読み込み開始位置からストリームの末尾までのバイト数（シークできなければ上限なし）
+    uint64_t StreamRemaining() {
+        const std::streampos begin = m_in.tellg();
+        if (begin == std::streampos(-1)) return UINT64_MAX;
+        m_in.seekg(0, std::ios::end);
+        const std::streampos end = m_in.tellg();
+        m_in.seekg(begin);
+        if (end == std::streampos(-1) || !m_in.good()) {
+            m_in.clear();
+            m_in.seekg(begin);
+            return UINT64_MAX;
+        }
+        return static_cast<uint64_t>(end - begin);
+    }
+
+    /// 残りのストリームにbytesバイトが収まるか
+    bool FitsInStream(uint64_t bytes) const {
+        return bytes <= m_streamBytes - m_consumed;
+    }
+
+    template<typename V>
+    void Process(V& value) {
+        if constexpr (std::is_arithmetic_v<V> || std::is_enum_v<V>) {
+            ReadRaw(value);
+        }
+        else {
+            static_assert(HasSlotGraphSerialize<V, SlotGraphReader>::value,
+                "SlotGraphReaderで読み込めない型です。Serializeを実装してください。");
+            value.Serialize(*this);
+        }
+    }
+
+    void Process(std::string& value) {
+        uint64_t size = 0;
+        ReadRaw(size);
+        if (!m_in.good() || !FitsInStream(size)) {
+            m_ok = false;
+            return;
+        }
+        value.resize(static_cast<size_t>(size));
+        m_in.read(value.data(), static_cast<std::streamsize>(size));
+        m_consumed += static_cast<uint64_t>(m_in.gcount());
+    }
+
+    /**
+     * @brief 配列を読み込む
+     *
+     * 算術型の配列は長さ分のバイト数がストリームに残っているか確かめてから一括で確保する。
+     * それ以外は要素ごとに1バイト以上を読み込む前提で長さを確かめ、
+     * 1つずつ読み込んで追加し、読み込みに失敗した時点で止める。
+     */
+    template<typename U>
+    void Process(std::vector<U>& values) {
+        static_assert(!std::is_same_v<U, bool>, "std::vector<bool>は未対応です。");
+        uint64_t size = 0;
+        ReadRaw(size);
+        values.clear();
+        if (!m_in.good() || !FitsInStream(size)) {
+            m_ok = false;
+            return;
+        }
+
+        if constexpr (std::is_arithmetic_v<U> || std::is_enum_v<U>) {
+            if (!FitsInStream(size * sizeof(U))) {
+                m_ok = false;
+                return;
+            }
+            values.resize(static_cast<size_t>(size));
+            for (U& value : values) {
+                ReadRaw(value);
+            }
+        }
+        else {
+            for (uint64_t i = 0; i < size && m_ok && m_in.good(); ++i) {
+                values.emplace_back();
+                Process(values.back());
+            }
+        }
+    }
+
+    template<typename U>
+    void Process(SlotPtr<U>& ptr) {
+        ptr = ResolveOwner<SlotPtr<U>>();
+    }
+
+    template<typename U>
+    void Process(SignalSlotPtr<U>& ptr) {
+        ptr = ResolveOwner<SignalSlotPtr<U>>();
+    }
+
+    /**
+     * @brief SlotRefのリンクを復元する
+     *
+     * 要素のアドレスにオフセットを足したポインタで参照を作り、参照カウントを加算する。
+     */
+    template<typename U>
+    void Process(SlotRef<U>& ref) {
+        SlotGraphLink link = ReadLink();
+        if (link.IsNull() || !IsValidLink(link)) {
+            ref = SlotRef<U>();
+            return;
+        }
+
+        SlotGraphPoolBase& pool = *m_pools[link.poolId];
+        unsigned char* bytes = pool.DataBegin()
+            + static_cast<size_t>(link.index) * pool.ElementSize()
+            + static_cast<size_t>(link.byteOffset);
+
+        pool.Control()->AddRefByIndex(link.index);
+        ref = SlotRef<U>(reinterpret_cast<U*>(bytes), pool.Control(), link.index);
+    }
+
+    /**
+     * @brief SlotPtr/SignalSlotPtrのリンクを復元する
+     *
+     * 参照先プールの所有者の型が一致する場合のみ、その所有者をコピーする。
+     */
+    template<typename Owner>
+    Owner ResolveOwner() {
+        SlotGraphLink link = ReadLink();
+        if (link.IsNull() || !IsValidLink(link)) return Owner();
+
+        SlotGraphPoolBase& pool = *m_pools[link.poolId];
+        if (pool.OwnerTypeKey() != SlotGraphTypeKey<Owner>() || link.byteOffset != 0) {
+            m_ok = false;
+            return Owner();
+        }
+        return *static_cast<const Owner*>(pool.OwnerAt(link.index));
+    }
+
+    SlotGraphLink ReadLink() {
+        SlotGraphLink link;
+        ReadRaw(link.poolId);
+        ReadRaw(link.index);
+        ReadRaw(link.byteOffset);
+        if (!m_in.good()) {
+            m_ok = false;
+            link.poolId = UINT32_MAX;
+        }
+        return link;
+    }
+
+    /// リンクが生存している要素の内側を指しているか検証する（不正ならエラーにする）
+    bool IsValidLink(const SlotGraphLink& link) {
+        bool valid = link.poolId < m_pools.size()
+            && link.index < m_alive[link.poolId].size()
+            && m_alive[link.poolId][link.index]
+            && link.byteOffset < m_pools[link.poolId]->ElementSize();
+        if (!valid) m_ok = false;
+        return valid;
+    }
+
+    /** 読み込み元 */
+    std::istream& m_in;
+
+    /** 登録されたプール */
+    std::vector<std::unique_ptr<SlotGraphPoolBase>> m_pools;
+
+    /** プールごとの各スロットの生存フラグ（書き込み時の状態） */
+    std::vector<std::vector<bool>> m_alive;
+
+    /** 読み込み開始時のストリームの残りのバイト数（不明ならUINT64_MAX） */
+    uint64_t m_streamBytes = UINT64_MAX;
+
+    /** 読み込み開始からのバイト数 */
+    uint64_t m_consumed = 0;
+
+    /** 読み込み中にエラーがなかったか */
+    bool m_ok = true;
+};
+
+template<template<typename> class Pool, typename T>
+void SlotGraphPool<Pool, T>::WriteObject(SlotGraphWriter& writer, uint32_t index) {
+    writer(*m_pool.Get(m_pool.HandleFromIndex(index)));
+}
+
+template<template<typename> class Pool, typename T>
+void SlotGraphPool<Pool, T>::ReadObject(SlotGraphReader& reader, uint32_t index) {
+    reader(*m_pool.Get(m_pool.HandleFromIndex(index)));
+}
\ No newline at end of file
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+
+// 前方宣言
+class SlotControlBase;
+
+/// 超えた閾値の種類
+enum class SlotBudgetLevel {
+    /** ソフト閾値（作成は続行する） */
+    Soft,
+
+    /** ハード閾値（コールバックで下回らなければ作成を拒否する） */
+    Hard
+};
+
+/**
+ * @brief 閾値を超えたときにコールバックへ渡す情報
+ */
+struct SlotBudgetEvent {
+    /** 超えた閾値の種類 */
+    SlotBudgetLevel level = SlotBudgetLevel::Soft;
+
+    /** 現在の使用量（バイト） */
+    size_t usedBytes = 0;
+
+    /** 超えた閾値（バイト） */
+    size_t limitBytes = 0;
+
+    /** 新しいスロットを追加しようとしたプール */
+    SlotControlBase* pool = nullptr;
+
+    /** 全体の予算ならtrue、プールごとの予算ならfalse */
+    bool global = false;
+};
+
+/// 閾値を超えたときに呼ばれるコールバック
+using SlotBudgetCallback = std::function<void(const SlotBudgetEvent&)>;
+
+/**
+ * @brief バイト単位のメモリ予算（ソフト閾値とハード閾値）
+ *
+ * プールが新しいスロットを末尾に追加する直前（PrepareCreate()）に使用量を評価する。
+ * 空きスロットを再利用する作成ではメモリが増えないため評価しない。
+ *
+ * - ソフト閾値: 超えた時点で1回だけコールバックを呼ぶ。下回ると再び呼ばれるようになる
+ * - ハード閾値: 超えている間は毎回コールバックを呼び、呼び出し後も超えていれば作成を拒否する
+ *
+ * コールバックではキャッシュの破棄、古い要素の解放、ShrinkToFit()などで使用量を減らす。
+ * コールバックの中で作成した要素に対しては、再びコールバックを呼ばない。
+ * コールバックの中で同じ予算を設定し直したり解除したりしないこと。
+ * 0の閾値は無効（無制限）を表す。
+ */
+struct SlotMemoryBudget {
+    /** ソフト閾値（バイト、0で無効） */
+    size_t softBytes = 0;
+
+    /** ハード閾値（バイト、0で無効） */
+    size_t hardBytes = 0;
+
+    /** 閾値を超えたときのコールバック */
+    SlotBudgetCallback callback;
+
+    /** ソフト閾値の通知済みフラグ（下回るとリセット） */
+    bool softNotified = false;
+
+    /** コールバックの実行中かどうか */
+    bool inCallback = false;
+
+    /**
+     * @brief 使用量を評価し、閾値を超えていればコールバックを呼ぶ
+     *
+     * @param pool 新しいスロットを追加しようとしたプール
+     * @param global 全体の予算かどうか
+     * @param measure 現在の使用量を返す関数
+     * @return 作成してよければtrue
+     */
+    template<typename Measure>
+    bool Enforce(SlotControlBase* pool, bool global, Measure&& measure) {
+        size_t used = measure();
+        if (inCallback) {
+            return hardBytes == 0 || used < hardBytes;
+        }
+
+        if (hardBytes != 0 && used >= hardBytes) {
+            Notify(SlotBudgetLevel::Hard, used, hardBytes, pool, global);
+            used = measure();
+            if (used >= hardBytes) return false;
+        }
+
+        if (softBytes != 0 && used >= softBytes) {
+            if (!softNotified) {
+                softNotified = true;
+                Notify(SlotBudgetLevel::Soft, used, softBytes, pool, global);
+            }
+        }
+        else {
+            softNotified = false;
+        }
+        return true;
+    }
+
+private:
+    /// コールバックを呼ぶ（実行中の再入を防ぐ）
+    void Notify(SlotBudgetLevel level, size_t used, size_t limit, SlotControlBase* pool, bool global) {
+        if (!callback) return;
+
+        SlotBudgetEvent event;
+        event.level = level;
+        event.usedBytes = used;
+        event.limitBytes = limit;
+        event.pool = pool;
+        event.global = global;
+
+        inCallback = true;
+        callback(event);
+        inCallback = false;
+    }
+};
+
+/**
+ * @brief 全てのプールの合計に対するメモリ予算
+ *
+ * SlotPoolRegistryに登録されている全プールのMemoryUsageBytes()の合計で評価する。
+ * いずれかのプールが新しいスロットを末尾に追加する直前に評価され、
+ * ハード閾値を超えたままなら、そのプールの作成を拒否する。
+ *
+ * 使用例:
+ * @code
+ *   SlotGlobalMemoryBudget::GetInstance().SetBudget(768u << 20, 1024u << 20,
+ *       [](const SlotBudgetEvent& event) {
+ *           textureCache.Trim();
+ *           ObjectSlotSystem<Mesh>::GetInstance().ShrinkToFit();
+ *       });
+ * @endcode
+ *
+ * 評価のたびに全プールを走査するため、プールを操作するスレッドから使うこと。
+ */
+class SlotGlobalMemoryBudget {
+public:
+    /// シングルトンインスタンスを取得
+    static SlotGlobalMemoryBudget& GetInstance() {
+        static SlotGlobalMemoryBudget instance;
+        return instance;
+    }
+
+    /// 全体の予算が設定されているかどうか（作成のたびに呼ばれる）
+    static bool IsActive() {
+        return s_active.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 全体の予算を設定する
+     *
+     * @param softBytes ソフト閾値（0で無効）
+     * @param hardBytes ハード閾値（0で無効）
+     * @param callback 閾値を超えたときのコールバック
+     */
+    void SetBudget(size_t softBytes, size_t hardBytes, SlotBudgetCallback callback) {
+        m_budget = SlotMemoryBudget{};
+        m_budget.softBytes = softBytes;
+        m_budget.hardBytes = hardBytes;
+        m_budget.callback = std::move(callback);
+        s_active.store(softBytes != 0 || hardBytes != 0, std::memory_order_relaxed);
+    }
+
+    /// 全体の予算を解除する
+    void ClearBudget() {
+        s_active.store(false, std::memory_order_relaxed);
+        m_budget = SlotMemoryBudget{};
+    }
+
+    /// 設定中の予算
+    SlotMemoryBudget& Budget() { return m_budget; }
+
+    // コピー・ムーブ禁止
+    SlotGlobalMemoryBudget(const SlotGlobalMemoryBudget&) = delete;
+    SlotGlobalMemoryBudget& operator=(const SlotGlobalMemoryBudget&) = delete;
+    SlotGlobalMemoryBudget(SlotGlobalMemoryBudget&&) = delete;
+    SlotGlobalMemoryBudget& operator=(SlotGlobalMemoryBudget&&) = delete;
+
+private:
+    SlotGlobalMemoryBudget() = default;
+    ~SlotGlobalMemoryBudget() {
+        s_active.store(false, std::memory_order_relaxed);
+    }
+
+    /** 全体の予算が設定されているかどうか */
+    static inline std::atomic<bool> s_active{ false };
+
+    /** 設定中の予算 */
+    SlotMemoryBudget m_budget;
+};
\ No newline at end of file
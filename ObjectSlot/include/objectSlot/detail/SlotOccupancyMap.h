@@ -0,0 +1,71 @@
+#pragma once
+
+#include "SlotControlBase.h"
+#include "SlotPoolRegistry.h"
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 全てのプールのページごとの占有状況をCSVで書き出す
+ *
+ * SlotPoolRegistryに登録されている全プールについて、要素配列のページごとに
+ * 生存・削除済みスロット数、コミット状態、最も古い生存要素の経過時間を1行ずつ出力する。
+ * 同じストリーム（またはファイル）に定期的に追記すると、時間経過による断片化の推移を追える。
+ * tools/occupancy_heatmap.py でヒートマップとして描画できる。
+ *
+ * 列: timestamp_ms,pool,page,first_slot,slots,live,dead,committed,oldest_age_ms
+ * - timestamp_ms: 書き出した時刻（UNIX時間のミリ秒）。同じ呼び出しの行は同じ値になる
+ * - oldest_age_ms: SetAgeTracking(true)にしたプールのみ。不明な場合は空欄
+ *
+ * 使用例:
+ * @code
+ *   ObjectSlotSystem<Mesh>::GetInstance().SetAgeTracking(true);
+ *   std::ofstream csv("occupancy.csv", std::ios::app);
+ *   ExportOccupancyMap(csv, csv.tellp() == 0);
+ * @endcode
+ *
+ * 各プールの中身を読むため、プールを操作するスレッドから呼ぶこと。
+ *
+ * @param out 書き出し先
+ * @param writeHeader 先頭に列名の行を書くかどうか
+ * @return 書き出したページの行数
+ */
+inline size_t ExportOccupancyMap(std::ostream& out, bool writeHeader = true) {
+    if (writeHeader) {
+        out << "timestamp_ms,pool,page,first_slot,slots,live,dead,committed,oldest_age_ms\n";
+    }
+
+    const long long timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    size_t rows = 0;
+    std::vector<SlotPageOccupancy> pages;
+    SlotPoolRegistry::GetInstance().ForEachPool([&](SlotControlBase& pool) {
+        pages.clear();
+        pool.CollectOccupancy(pages);
+        if (pages.empty()) return;
+
+        // 型名に区切り文字が含まれても壊れないよう、二重引用符で囲む
+        std::string name = "\"";
+        for (const char* c = pool.PoolTypeName(); *c != '\0'; ++c) {
+            if (*c == '"') name += '"';
+            name += *c;
+        }
+        name += '"';
+
+        for (const SlotPageOccupancy& page : pages) {
+            out << timestamp << ',' << name << ',' << page.page << ',' << page.firstSlot << ','
+                << page.slots << ',' << page.live << ',' << page.dead << ','
+                << (page.committed ? 1 : 0) << ',';
+            if (page.oldestAgeNs != SlotPageOccupancy::UNKNOWN_AGE) {
+                out << page.oldestAgeNs / 1000000;
+            }
+            out << '\n';
+        }
+        rows += pages.size();
+    });
+    return rows;
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// 前方宣言
+class SlotControlBase;
+
+/**
+ * @brief プールのページ1つ分の占有状況
+ *
+ * 要素配列をOSのページ単位に区切り、先頭がそのページにあるスロットを集計する。
+ * 要素がページより大きい場合、スロットの先頭を含まないページは全て0になる。
+ */
+struct SlotPageOccupancy {
+    /** 古さが不明（追跡していない）ことを表す値 */
+    static constexpr uint64_t UNKNOWN_AGE = UINT64_MAX;
+
+    /** 要素配列の先頭からのページ番号 */
+    size_t page = 0;
+
+    /** このページで始まる最初のスロットのインデックス */
+    size_t firstSlot = 0;
+
+    /** このページで始まるスロット数 */
+    size_t slots = 0;
+
+    /** 生存しているスロット数 */
+    size_t live = 0;
+
+    /** 削除済み（再利用待ち）のスロット数 */
+    size_t dead = 0;
+
+    /** ページが物理メモリにコミットされているか */
+    bool committed = false;
+
+    /** 最も古い生存要素の経過時間（ナノ秒、不明ならUNKNOWN_AGE） */
+    uint64_t oldestAgeNs = UNKNOWN_AGE;
+};
+
+/**
+ * @brief 生成された全てのプールを登録しておくレジストリ
+ *
+ * SlotControlBaseのコンストラクタで登録、デストラクタで解除される。
+ * ExportOccupancyMap()等の、全プールを横断する診断機能から使う。
+ *
+ * 登録と走査はミューテックスで保護されるが、
+ * 各プールの中身を読む処理はプールを操作するスレッドから呼ぶこと。
+ */
+class SlotPoolRegistry {
+public:
+    /// シングルトンインスタンスを取得
+    static SlotPoolRegistry& GetInstance() {
+        static SlotPoolRegistry instance;
+        return instance;
+    }
+
+    /// プールを登録する
+    void Register(SlotControlBase* pool) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pools.push_back(pool);
+    }
+
+    /// プールの登録を解除する
+    void Unregister(SlotControlBase* pool) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pools.erase(std::remove(m_pools.begin(), m_pools.end(), pool), m_pools.end());
+    }
+
+    /**
+     * @brief 登録されている全てのプールに対して処理を実行（登録順）
+     *
+     * @param func func(SlotControlBase&) の形で呼べる関数
+     */
+    template<typename Func>
+    void ForEachPool(Func&& func) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (SlotControlBase* pool : m_pools) {
+            func(*pool);
+        }
+    }
+
+    // コピー・ムーブ禁止
+    SlotPoolRegistry(const SlotPoolRegistry&) = delete;
+    SlotPoolRegistry& operator=(const SlotPoolRegistry&) = delete;
+    SlotPoolRegistry(SlotPoolRegistry&&) = delete;
+    SlotPoolRegistry& operator=(SlotPoolRegistry&&) = delete;
+
+private:
+    SlotPoolRegistry() = default;
+    ~SlotPoolRegistry() = default;
+
+    /** 登録の追加・削除を保護するミューテックス */
+    std::mutex m_mutex;
+
+    /** 登録されているプール */
+    std::vector<SlotControlBase*> m_pools;
+};
\ No newline at end of file
@@ -11,6 +11,9 @@ class ObjectSlotSystemBase;
 template<typename T>
 class WeakSlotPtr;
 
+template<typename T>
+class UniqueSlotPtr;
+
 class SlotControlBase;
 
 /**
@@ -51,6 +54,13 @@ public:
     {
     }
 
+    /**
+     * @brief UniqueSlotPtrからの変換（所有権を共有可能にする）
+     *
+     * 作成時の参照カウント1をそのまま引き継ぐため、参照カウントは変化しない。
+     */
+    SlotPtr(UniqueSlotPtr<T>&& other);
+
     /// コピーコンストラクタ
     SlotPtr(const SlotPtr& other)
         : m_root_ptr(other.m_root_ptr)
@@ -11,6 +11,11 @@
 template<typename T>
 class SignalSlotPtr;
 
+class SlotGraphReader;
+
+template<typename... Types>
+class VariantSlotSystem;
+
 /**
  * @brief ポリモーフィック対応の参照カウント付きスマートポインタ
  *
@@ -32,6 +37,17 @@ class SignalSlotPtr;
  */
 template<typename T>
 class SlotRef {
+    // 変換コンストラクタが他の型のSlotRefのprivateメンバにアクセスするため
+    template<typename U>
+    friend class SlotRef;
+
+    // SlotRefを直接返すプールが参照カウント済みのSlotRefを構築するため
+    template<typename... Types>
+    friend class VariantSlotSystem;
+
+    // 読み込んだグラフのSlotRefを参照カウント済みの状態で復元するため
+    friend class SlotGraphReader;
+
 public:
     /// デフォルトコンストラクタ
     SlotRef()
@@ -99,6 +115,32 @@ public:
         }
     }
 
+    /**
+     * @brief 派生型のSlotRefからの変換コンストラクタ
+     *
+     * SlotRef<U>からSlotRef<T>への変換を行う。
+     * UがTの派生クラスである場合のみコンパイル可能。
+     * 参照カウントを共有し、新しいSlotRefとしてプールに登録する。
+     *
+     * @tparam U 元のSlotRefの要素型（Tの派生型）
+     * @param other 変換元のSlotRef
+     */
+    template<typename U, std::enable_if_t<std::is_base_of_v<T, U> && !std::is_same_v<T, U>, int> = 0>
+    SlotRef(const SlotRef<U>& other)
+        : m_ptr(nullptr)
+        , m_control(nullptr)
+    {
+        if (other.m_ptr != nullptr && other.m_control != nullptr) {
+            uint32_t index = other.ResolveIndex(&other.m_ptr);
+            m_ptr = static_cast<T*>(other.m_ptr);
+            m_control = other.m_control;
+
+            m_control->AddRefByIndex(index);
+            m_control->RegisterRef(
+                reinterpret_cast<void**>(&m_ptr), index);
+        }
+    }
+
     /**
      * @brief SlotPtrからのエイリアシングコンストラクタ
      *
@@ -320,6 +362,11 @@ public:
         return m_ptr != nullptr;
     }
 
+    /// プールの非テンプレート基底を取得
+    SlotControlBase* GetControl() const {
+        return m_control;
+    }
+
     /// bool変換演算子
     explicit operator bool() const { return IsValid(); }
 
@@ -420,6 +467,24 @@ public:
     bool operator>=(const SlotRef& other) const { return !(*this < other); }
 
 private:
+    /**
+     * @brief 参照カウント加算済みの要素を引き受けるコンストラクタ
+     *
+     * SlotRefを直接返すプール（VariantSlotSystem）が、
+     * 作成した要素の最初の参照として使う。参照カウントは変化させない。
+     *
+     * @param ptr 要素へのポインタ
+     * @param control 要素が属するプール
+     * @param index 要素のスロットインデックス
+     */
+    SlotRef(T* ptr, SlotControlBase* control, uint32_t index)
+        : m_ptr(ptr)
+        , m_control(control)
+    {
+        m_control->RegisterRef(
+            reinterpret_cast<void**>(&m_ptr), index);
+    }
+
     /**
      * @brief コピー元のポインタ位置からスロットインデックスを解決する
      *
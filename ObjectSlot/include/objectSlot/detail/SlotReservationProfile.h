@@ -0,0 +1,269 @@
+#pragma once
+
+#include "SlotControlBase.h"
+#include "SlotPoolRegistry.h"
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+
+/**
+ * @brief 実行中の各プールのピーク使用量を記録し、次回起動時の事前確保に使うプロファイル
+ *
+ * 各プールは生存要素数のピークとコミット済みバイト数のピークを記録している。
+ * SetSavePath()でパスを指定すると、プロセス終了時（プールが全て破棄された後）に
+ * プールごとのピークを小さなテキストファイルに書き出す。
+ * 次回の起動時にLoad()で読み込むと、各プールが作成された時点で
+ * 前回のピーク分の容量をReserve()し、ウォームアップ中の段階的なコミットと拡張を省く。
+ *
+ * プールは型名（typeid(T).name()）で識別するため、同じビルドの実行ファイル間で有効。
+ * 書き出すのは今回の実行のピークで、今回作成されなかったプールは読み込んだ値を引き継ぐ。
+ * 数値として読めない行や、数値がsize_tに収まらない行（壊れたファイル）は無視する。
+ * プールの上限で切り詰めた場合や確保に失敗した場合は、FailedReservationCount()に数えられる。
+ *
+ * ファイル形式（1行1プール）:
+ * @code
+ *   # ObjectSlot reservation profile v1
+ *   # peak_count,peak_committed_bytes,pool
+ *   120000,1966080,4Mesh
+ * @endcode
+ *
+ * 通常はLoadReservationProfile()で読み込みと書き出し先の指定をまとめて行う。
+ */
+class SlotReservationProfile {
+public:
+    /// プール1つ分の記録
+    struct Entry {
+        /** 生存要素数のピーク */
+        size_t peakCount = 0;
+
+        /** コミット済みバイト数のピーク */
+        size_t peakCommittedBytes = 0;
+    };
+
+    /// シングルトンインスタンスを取得
+    static SlotReservationProfile& GetInstance() {
+        static SlotReservationProfile instance;
+        return instance;
+    }
+
+    /**
+     * @brief プロファイルを読み込み、作成済みのプールに適用する
+     *
+     * まだ作成されていないプールには、作成時に適用される。
+     *
+     * @param path プロファイルのパス
+     * @param prefault trueなら確保した領域のページを事前に割り当てる（初回書き込み時のページフォルトを省く）
+     * @return 読み込んだプールの数（ファイルがなければ0）
+     */
+    size_t Load(const std::string& path, bool prefault = false) {
+        std::ifstream in(path);
+        size_t loaded = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_prefault = prefault;
+            std::string line;
+            while (std::getline(in, line)) {
+                if (line.empty() || line[0] == '#') continue;
+
+                const size_t first = line.find(',');
+                const size_t second = first == std::string::npos ? first : line.find(',', first + 1);
+                if (second == std::string::npos) continue;
+
+                size_t peakCount = 0;
+                size_t peakBytes = 0;
+                if (!ParseSize(line.c_str(), line.c_str() + first, peakCount)
+                    || !ParseSize(line.c_str() + first + 1, line.c_str() + second, peakBytes)) {
+                    continue;
+                }
+
+                Entry entry;
+                entry.peakCount = peakCount;
+                entry.peakCommittedBytes = peakBytes;
+                m_loaded[line.substr(second + 1)] = entry;
+                ++loaded;
+            }
+        }
+
+        SlotPoolRegistry::GetInstance().ForEachPool([this](SlotControlBase& pool) {
+            ApplyTo(pool);
+        });
+        return loaded;
+    }
+
+    /**
+     * @brief 現在のピークをプロファイルとして書き出す
+     *
+     * 作成済みのプールと破棄済みのプールの記録、読み込んだだけのプールの値をまとめて書く。
+     *
+     * @return 書き出したプールの数（書き込めなければ0）
+     */
+    size_t Save(const std::string& path) {
+        SlotPoolRegistry::GetInstance().ForEachPool([this](SlotControlBase& pool) {
+            Record(pool);
+        });
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::map<std::string, Entry> entries = m_loaded;
+        for (const auto& recorded : m_recorded) {
+            entries[recorded.first] = recorded.second;
+        }
+
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) return 0;
+        out << "# ObjectSlot reservation profile v1\n";
+        out << "# peak_count,peak_committed_bytes,pool\n";
+        for (const auto& entry : entries) {
+            out << entry.second.peakCount << ',' << entry.second.peakCommittedBytes << ',' << entry.first << '\n';
+        }
+        return entries.size();
+    }
+
+    /// プロセス終了時にプロファイルを書き出すパスを指定する（空なら書き出さない）
+    void SetSavePath(const std::string& path) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_savePath = path;
+    }
+
+    /// 読み込んだ記録を取得（記録がなければnullptr）
+    const Entry* FindLoaded(const std::string& key) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_loaded.find(key);
+        return it == m_loaded.end() ? nullptr : &it->second;
+    }
+
+    /**
+     * @brief 読み込んだ記録をプールに適用する
+     *
+     * プールの作成時（ObjectSlotSystemBaseのコンストラクタ）とLoad()から呼ばれる。
+     *
+     * @return 記録どおりに確保できたか、記録がない場合はtrue
+     */
+    bool ApplyTo(SlotControlBase& pool) {
+        const char* key = pool.PoolTypeKey();
+        if (key == nullptr) return true;
+
+        size_t count = 0;
+        bool prefault = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_loaded.find(key);
+            if (it == m_loaded.end()) return true;
+            count = it->second.peakCount;
+            prefault = m_prefault;
+        }
+        if (count == 0 || pool.ApplyReservation(count, prefault)) return true;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_failedReservations;
+        return false;
+    }
+
+    /// 記録どおりに事前確保できなかった回数
+    size_t FailedReservationCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_failedReservations;
+    }
+
+    /**
+     * @brief プールのピークを記録する
+     *
+     * プールの破棄時（ObjectSlotSystemBaseのデストラクタ）とSave()から呼ばれる。
+     * 書き出し先が指定されていなければ、破棄時の記録は行わない。
+     */
+    void Record(const SlotControlBase& pool) {
+        const char* key = pool.PoolTypeKey();
+        if (key == nullptr) return;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Entry& entry = m_recorded[key];
+        if (pool.PeakCount() > entry.peakCount) entry.peakCount = pool.PeakCount();
+        if (pool.PeakCommittedBytes() > entry.peakCommittedBytes) entry.peakCommittedBytes = pool.PeakCommittedBytes();
+    }
+
+    /// プールの破棄時に記録が必要かどうか
+    bool IsRecording() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return !m_savePath.empty();
+    }
+
+    // コピー・ムーブ禁止
+    SlotReservationProfile(const SlotReservationProfile&) = delete;
+    SlotReservationProfile& operator=(const SlotReservationProfile&) = delete;
+    SlotReservationProfile(SlotReservationProfile&&) = delete;
+    SlotReservationProfile& operator=(SlotReservationProfile&&) = delete;
+
+private:
+    SlotReservationProfile() = default;
+
+    /// [begin, end)がsize_tに収まる10進数ならtrue
+    static bool ParseSize(const char* begin, const char* end, size_t& value) {
+        if (begin == end || *begin < '0' || *begin > '9') return false;
+
+        char* parsedEnd = nullptr;
+        errno = 0;
+        const unsigned long long parsed = std::strtoull(begin, &parsedEnd, 10);
+        if (parsedEnd != end || errno == ERANGE || parsed > SIZE_MAX) return false;
+
+        value = static_cast<size_t>(parsed);
+        return true;
+    }
+
+    /// 全てのプールが破棄された後に呼ばれ、指定されていればプロファイルを書き出す
+    ~SlotReservationProfile() {
+        std::string path;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            path = m_savePath;
+        }
+        if (!path.empty()) {
+            Save(path);
+        }
+    }
+
+    /** メンバを保護するミューテックス */
+    mutable std::mutex m_mutex;
+
+    /** 読み込んだ記録（型名→ピーク） */
+    std::map<std::string, Entry> m_loaded;
+
+    /** 今回の実行で記録したピーク（型名→ピーク） */
+    std::map<std::string, Entry> m_recorded;
+
+    /** プロセス終了時の書き出し先 */
+    std::string m_savePath;
+
+    /** 記録どおりに事前確保できなかった回数 */
+    size_t m_failedReservations = 0;
+
+    /** 適用時にページを事前に割り当てるかどうか */
+    bool m_prefault = false;
+};
+
+/**
+ * @brief 前回の実行のピークでプールを事前確保し、今回のピークを終了時に同じファイルへ書き出す
+ *
+ * main()の先頭など、プールを使い始める前に呼ぶ。
+ * ファイルがなければ（初回の実行）何も確保せず、終了時に新しく書き出す。
+ *
+ * @code
+ *   int main() {
+ *       LoadReservationProfile("pools.profile");
+ *       // ...
+ *   }
+ * @endcode
+ *
+ * @param path プロファイルのパス
+ * @param prefault trueなら確保した領域のページを事前に割り当てる
+ * @return 読み込んだプールの数
+ */
+inline size_t LoadReservationProfile(const std::string& path, bool prefault = false) {
+    SlotReservationProfile& profile = SlotReservationProfile::GetInstance();
+    size_t loaded = profile.Load(path, prefault);
+    profile.SetSavePath(path);
+    return loaded;
+}
\ No newline at end of file
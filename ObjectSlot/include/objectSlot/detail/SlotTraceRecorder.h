@@ -0,0 +1,272 @@
+#pragma once
+
+#include "SlotControlBase.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief トレースイベント1件分の記録
+ */
+struct SlotTraceEvent {
+    /** イベント名（文字列リテラルを指す） */
+    const char* name = nullptr;
+
+    /** 'B'（開始）または'E'（終了） */
+    char phase = 'B';
+
+    /** プール名（記録時にコピーする） */
+    char pool[47] = {};
+
+    /** スロットインデックス */
+    uint32_t index = 0;
+
+    /** 呼び出した購読者数、または処理件数 */
+    uint32_t count = 0;
+
+    /** 記録したスレッドの識別子 */
+    uint32_t thread = 0;
+
+    /** 記録時刻（ナノ秒） */
+    uint64_t timestampNs = 0;
+};
+
+/**
+ * @brief 解放の連鎖を可視化するためのトレースイベント記録
+ *
+ * 有効にすると、プールの削除処理の開始・終了をリングバッファに記録する。
+ * WriteChromeTrace()でChromeのトレース形式（JSON）に書き出し、
+ * chrome://tracing や Perfetto (ui.perfetto.dev) で読み込むと、
+ * 1回の解放から連鎖した通知と削除が入れ子の区間として表示される。
+ *
+ * 記録されるイベント:
+ * - Destroy: 要素の削除（デストラクタを含む）。全てのプール
+ * - ExecuteRemoval: 購読者への通知と削除。SignalSlotSystem/RefSlotSystemのみ（countは購読者数）
+ * - ProcessPendingRemovals: 削除や通知の中で発生した遅延削除の一括処理。全てのプール（countは開始時点で待っている件数）
+ *
+ * リングバッファが一杯になると古いイベントから上書きされる。
+ * 無効の間の追加コストはアトミック変数の読み込み1回だけ。
+ *
+ * 使用例:
+ * @code
+ *   SlotTraceRecorder::GetInstance().Enable(1 << 16);
+ *   // ... 問題の解放を再現する ...
+ *   std::ofstream json("release_trace.json");
+ *   SlotTraceRecorder::GetInstance().WriteChromeTrace(json);
+ * @endcode
+ */
+class SlotTraceRecorder {
+public:
+    /// シングルトンインスタンスを取得
+    static SlotTraceRecorder& GetInstance() {
+        static SlotTraceRecorder instance;
+        return instance;
+    }
+
+    /// 記録が有効かどうか（フックから毎回呼ばれる）
+    static bool IsEnabled() {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 記録を開始する
+     *
+     * @param capacity リングバッファに保持するイベント数
+     */
+    void Enable(size_t capacity) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_events.assign(capacity > 0 ? capacity : 1, SlotTraceEvent{});
+        m_next = 0;
+        m_recorded = 0;
+        s_enabled.store(true, std::memory_order_relaxed);
+    }
+
+    /// 記録を停止する（記録済みのイベントは保持する）
+    void Disable() {
+        s_enabled.store(false, std::memory_order_relaxed);
+    }
+
+    /// 記録済みのイベントを消去する
+    void Clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_next = 0;
+        m_recorded = 0;
+    }
+
+    /// 保持しているイベント数
+    size_t EventCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_recorded < m_events.size() ? static_cast<size_t>(m_recorded) : m_events.size();
+    }
+
+    /// 上書きで失われたイベント数
+    uint64_t DroppedCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_recorded > m_events.size() ? m_recorded - m_events.size() : 0;
+    }
+
+    /**
+     * @brief イベントを1件記録する
+     *
+     * @param name イベント名（文字列リテラル）
+     * @param phase 'B'（開始）または'E'（終了）
+     * @param pool プール名
+     * @param index スロットインデックス
+     * @param count 購読者数や処理件数
+     */
+    void Record(const char* name, char phase, const char* pool, uint32_t index, uint32_t count) {
+        SlotTraceEvent event;
+        event.name = name;
+        event.phase = phase;
+        std::strncpy(event.pool, pool, sizeof(event.pool) - 1);
+        event.index = index;
+        event.count = count;
+        event.thread = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        event.timestampNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_events.empty()) return;
+        m_events[m_next] = event;
+        m_next = (m_next + 1) % m_events.size();
+        ++m_recorded;
+    }
+
+    /**
+     * @brief 記録済みのイベントを古い順に処理する
+     *
+     * @param func func(const SlotTraceEvent&) の形で呼べる関数
+     */
+    template<typename Func>
+    void ForEachEvent(Func&& func) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const size_t size = m_recorded < m_events.size() ? static_cast<size_t>(m_recorded) : m_events.size();
+        const size_t start = m_recorded < m_events.size() ? 0 : m_next;
+        for (size_t i = 0; i < size; ++i) {
+            func(m_events[(start + i) % m_events.size()]);
+        }
+    }
+
+    /**
+     * @brief Chromeのトレース形式（JSON）で書き出す
+     *
+     * タイムスタンプは最初のイベントからの経過時間（マイクロ秒）になる。
+     *
+     * @return 書き出したイベント数
+     */
+    size_t WriteChromeTrace(std::ostream& out) const {
+        out << "{\"traceEvents\":[";
+        size_t written = 0;
+        uint64_t origin = 0;
+        ForEachEvent([&](const SlotTraceEvent& event) {
+            if (written == 0) origin = event.timestampNs;
+            out << (written == 0 ? "\n" : ",\n")
+                << "{\"name\":\"" << event.name << "\",\"cat\":\"ObjectSlot\",\"ph\":\"" << event.phase
+                << "\",\"ts\":" << static_cast<double>(event.timestampNs - origin) / 1000.0
+                << ",\"pid\":1,\"tid\":" << event.thread;
+            if (event.phase == 'B') {
+                out << ",\"args\":{\"pool\":\"";
+                WriteEscaped(out, event.pool);
+                out << "\",\"index\":" << event.index << ",\"count\":" << event.count << "}";
+            }
+            out << "}";
+            ++written;
+        });
+        out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+        return written;
+    }
+
+    // コピー・ムーブ禁止
+    SlotTraceRecorder(const SlotTraceRecorder&) = delete;
+    SlotTraceRecorder& operator=(const SlotTraceRecorder&) = delete;
+    SlotTraceRecorder(SlotTraceRecorder&&) = delete;
+    SlotTraceRecorder& operator=(SlotTraceRecorder&&) = delete;
+
+private:
+    SlotTraceRecorder() = default;
+    ~SlotTraceRecorder() {
+        s_enabled.store(false, std::memory_order_relaxed);
+    }
+
+    /// JSON文字列として書き出す（引用符・バックスラッシュ・制御文字をエスケープ）
+    static void WriteEscaped(std::ostream& out, const char* text) {
+        for (const char* c = text; *c != '\0'; ++c) {
+            if (*c == '"' || *c == '\\') {
+                out << '\\' << *c;
+            }
+            else if (static_cast<unsigned char>(*c) < 0x20) {
+                out << ' ';
+            }
+            else {
+                out << *c;
+            }
+        }
+    }
+
+    /** 記録が有効かどうか */
+    static inline std::atomic<bool> s_enabled{ false };
+
+    /** リングバッファを保護するミューテックス */
+    mutable std::mutex m_mutex;
+
+    /** イベントのリングバッファ */
+    std::vector<SlotTraceEvent> m_events;
+
+    /** 次に書き込む位置 */
+    size_t m_next = 0;
+
+    /** これまでに記録したイベントの総数 */
+    uint64_t m_recorded = 0;
+};
+
+/**
+ * @brief 区間の開始と終了を記録するRAIIヘルパー
+ *
+ * 記録が無効な場合は何もしない。区間の途中で有効・無効が切り替わっても
+ * 開始を記録した区間は必ず終了も記録する。
+ */
+class SlotTraceScope {
+public:
+    /**
+     * @param name イベント名（文字列リテラル）
+     * @param pool 対象のプール（記録が有効な場合のみプール名を取得する）
+     * @param index スロットインデックス
+     * @param count 購読者数や処理件数
+     */
+    SlotTraceScope(const char* name, const SlotControlBase& pool, uint32_t index, uint32_t count)
+        : m_name(SlotTraceRecorder::IsEnabled() ? name : nullptr)
+        , m_pool(&pool)
+        , m_index(index)
+    {
+        if (m_name != nullptr) {
+            SlotTraceRecorder::GetInstance().Record(m_name, 'B', m_pool->PoolTypeName(), m_index, count);
+        }
+    }
+
+    ~SlotTraceScope() {
+        if (m_name != nullptr) {
+            SlotTraceRecorder::GetInstance().Record(m_name, 'E', m_pool->PoolTypeName(), m_index, 0);
+        }
+    }
+
+    // コピー・ムーブ禁止
+    SlotTraceScope(const SlotTraceScope&) = delete;
+    SlotTraceScope& operator=(const SlotTraceScope&) = delete;
+
+private:
+    /** イベント名（記録しない場合はnullptr） */
+    const char* m_name;
+
+    /** 対象のプール */
+    const SlotControlBase* m_pool;
+
+    /** スロットインデックス */
+    uint32_t m_index;
+};
\ No newline at end of file
@@ -0,0 +1,273 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief 固定容量プール用のハンドル
+ *
+ * インデックスと世代番号の型を容量Nに合わせて選択する。
+ * N <= 65535の場合はuint16_tの組（4バイト）、それ以外はuint32_tの組（8バイト）になる。
+ *
+ * 世代番号の幅が小さいため、同じスロットが65536回再利用されると
+ * 古いハンドルが再び有効に見える可能性がある点に注意。
+ *
+ * @tparam N 対応するプールの容量
+ */
+template<size_t N>
+struct StaticSlotHandle {
+    /** インデックスと世代番号の型 */
+    using IndexType = std::conditional_t<(N <= 0xFFFF), uint16_t, uint32_t>;
+
+    /** 無効なインデックスを表す定数 */
+    static constexpr IndexType INVALID_INDEX = std::numeric_limits<IndexType>::max();
+
+    /** プール内のインデックス */
+    IndexType index = INVALID_INDEX;
+
+    /** 世代番号 (スロット再利用時にインクリメントされる) */
+    IndexType generation = 0;
+
+    /// 等価比較演算子
+    constexpr bool operator==(const StaticSlotHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+
+    /// 非等価比較演算子
+    constexpr bool operator!=(const StaticSlotHandle& other) const {
+        return !(*this == other);
+    }
+
+    /// ハンドルが有効かどうかを判定
+    constexpr bool IsValid() const { return index != INVALID_INDEX; }
+
+    /// 無効なハンドルを生成
+    static constexpr StaticSlotHandle Invalid() { return {}; }
+};
+
+/**
+ * @brief コンパイル時に容量が決まる固定容量オブジェクトプール
+ *
+ * 要素とメタデータを全てインスタンス内の配列に持ち、
+ * 仮想メモリの予約やヒープ確保を一切行わない。
+ * 容量が小さく上限が分かっている高頻度のプール
+ * （組み込み向けサブシステム、スレッドごとの作業用プール等）を想定している。
+ *
+ * ObjectSlotSystemと異なり参照カウントは持たず、
+ * Create()が返すハンドルで要素を識別し、Destroy()で明示的に破棄する。
+ * シングルトンではないため、必要な場所にインスタンスを置いて使う。
+ *
+ * 使用例:
+ * @code
+ *   thread_local StaticSlotSystem<Particle, 256> scratch;
+ *   auto h = scratch.Create(Particle{});
+ *   if (Particle* p = scratch.Get(h)) { ... }
+ *   scratch.Destroy(h);
+ * @endcode
+ *
+ * @tparam T 管理する要素の型
+ * @tparam N 最大要素数
+ */
+template<typename T, size_t N>
+class StaticSlotSystem {
+    static_assert(N > 0, "StaticSlotSystemの容量は1以上を指定してください。");
+    static_assert(N < UINT32_MAX, "StaticSlotSystemの容量が大きすぎます。");
+
+public:
+    /** このプールのハンドル型 */
+    using Handle = StaticSlotHandle<N>;
+
+    /** インデックスと世代番号の型 */
+    using IndexType = typename Handle::IndexType;
+
+    /** 最大要素数 */
+    static constexpr size_t MaxCount = N;
+
+    StaticSlotSystem() = default;
+
+    /// 生存している全要素を破棄する
+    ~StaticSlotSystem() { Clear(); }
+
+    // コピー・ムーブ禁止（要素のアドレスをインスタンスに固定するため）
+    StaticSlotSystem(const StaticSlotSystem&) = delete;
+    StaticSlotSystem& operator=(const StaticSlotSystem&) = delete;
+    StaticSlotSystem(StaticSlotSystem&&) = delete;
+    StaticSlotSystem& operator=(StaticSlotSystem&&) = delete;
+
+    /**
+     * @brief 新しい要素を作成
+     *
+     * @param obj 追加する要素 (ムーブされる)
+     * @return 作成された要素のハンドル。容量が一杯の場合は無効ハンドル
+     */
+    Handle Create(T&& obj) {
+        return Emplace(std::move(obj));
+    }
+
+    /**
+     * @brief 引数を転送して新しい要素をスロット上に直接構築
+     *
+     * 空きスロットは構築に成功してから確定するため、
+     * Tのコンストラクタが例外を投げてもスロットは失われない。
+     *
+     * @return 作成された要素のハンドル。容量が一杯の場合は無効ハンドル
+     */
+    template<typename... Args>
+    Handle Emplace(Args&&... args) {
+        IndexType index;
+        if (m_freeCount > 0) {
+            index = m_freeList[m_freeCount - 1];
+        }
+        else if (m_used < N) {
+            index = m_used;
+        }
+        else {
+            return Handle::Invalid();
+        }
+
+        new (&m_storage[index]) T(std::forward<Args>(args)...);
+        if (m_freeCount > 0) {
+            --m_freeCount;
+        }
+        else {
+            ++m_used;
+        }
+        m_alive[index] = true;
+        ++m_count;
+
+        Handle handle;
+        handle.index = index;
+        handle.generation = m_generations[index];
+        return handle;
+    }
+
+    /**
+     * @brief 要素を破棄してスロットを解放する
+     *
+     * @param handle 破棄する要素のハンドル
+     * @return 破棄できた場合はtrue。ハンドルが無効な場合はfalse
+     */
+    bool Destroy(Handle handle) {
+        if (!IsValidHandle(handle)) return false;
+
+        At(handle.index).~T();
+        m_alive[handle.index] = false;
+        ++m_generations[handle.index];
+        m_freeList[m_freeCount++] = handle.index;
+        --m_count;
+        return true;
+    }
+
+    /// ハンドルが有効かどうかを検証
+    bool IsValidHandle(Handle handle) const {
+        return handle.index < m_used
+            && m_alive[handle.index]
+            && m_generations[handle.index] == handle.generation;
+    }
+
+    /// ハンドルから要素を取得
+    T* Get(Handle handle) {
+        if (!IsValidHandle(handle)) return nullptr;
+        return &At(handle.index);
+    }
+
+    /// ハンドルから要素を取得 (const版)
+    const T* Get(Handle handle) const {
+        if (!IsValidHandle(handle)) return nullptr;
+        return &At(handle.index);
+    }
+
+    /// 全ての有効な要素に対して処理を実行
+    template<typename Func>
+    void ForEach(Func&& func) {
+        for (IndexType i = 0; i < m_used; ++i) {
+            if (m_alive[i]) {
+                Handle h;
+                h.index = i;
+                h.generation = m_generations[i];
+                func(h, At(i));
+            }
+        }
+    }
+
+    /// 全ての有効な要素に対して処理を実行 (const版)
+    template<typename Func>
+    void ForEach(Func&& func) const {
+        for (IndexType i = 0; i < m_used; ++i) {
+            if (m_alive[i]) {
+                Handle h;
+                h.index = i;
+                h.generation = m_generations[i];
+                func(h, At(i));
+            }
+        }
+    }
+
+    /**
+     * @brief 全要素を破棄する
+     *
+     * 世代番号は維持するため、Clear前のハンドルはClear後も無効のまま。
+     */
+    void Clear() {
+        for (IndexType i = 0; i < m_used; ++i) {
+            if (m_alive[i]) {
+                At(i).~T();
+                m_alive[i] = false;
+                ++m_generations[i];
+                m_freeList[m_freeCount++] = i;
+            }
+        }
+        m_count = 0;
+    }
+
+    /// 有効な要素数を取得
+    size_t Count() const { return m_count; }
+
+    /// 最大要素数を取得
+    static constexpr size_t Capacity() { return N; }
+
+    /// 容量が一杯かどうかを判定
+    bool IsFull() const { return m_count == N; }
+
+private:
+    /// スロット上の要素への参照を取得
+    T& At(IndexType index) {
+        return *std::launder(reinterpret_cast<T*>(&m_storage[index]));
+    }
+
+    /// スロット上の要素への参照を取得 (const版)
+    const T& At(IndexType index) const {
+        return *std::launder(reinterpret_cast<const T*>(&m_storage[index]));
+    }
+
+    /** 要素1個分の未初期化ストレージ */
+    struct alignas(T) Storage {
+        unsigned char bytes[sizeof(T)];
+    };
+
+    /** 要素のインライン配置ストレージ */
+    std::array<Storage, N> m_storage;
+
+    /** 各スロットの世代番号 */
+    std::array<IndexType, N> m_generations{};
+
+    /** 各スロットの生存フラグ */
+    std::array<bool, N> m_alive{};
+
+    /** 再利用可能なスロットのインデックス（末尾から取り出すスタック） */
+    std::array<IndexType, N> m_freeList;
+
+    /** フリーリストの要素数 */
+    IndexType m_freeCount = 0;
+
+    /** 一度でも使用されたスロット数（この位置より後ろは未使用） */
+    IndexType m_used = 0;
+
+    /** 有効な要素数 */
+    IndexType m_count = 0;
+};
\ No newline at end of file
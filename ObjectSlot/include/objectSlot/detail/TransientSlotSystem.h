@@ -0,0 +1,139 @@
+#pragma once
+
+#include "SlotHandle.h"
+#include "thirdparty/rootVector/RootVector.h"
+#include <cstdint>
+#include <utility>
+
+/**
+ * @brief フレーム単位の一時オブジェクト用プール
+ *
+ * 1フレームだけ使う一時オブジェクト（描画コマンド、衝突結果、パーティクルの生成要求等）を
+ * root_vectorの予約領域の末尾に順に積むだけで確保する。
+ * 参照カウント、生存フラグ、フリーリストは持たず、個別の解放もできない。
+ * ResetFrame()で全要素の寿命をまとめて終わらせる。
+ *
+ * ハンドルの世代番号にはフレーム番号（エポック）を入れる。
+ * ResetFrame()でフレーム番号が進むため、前のフレームのハンドルは全て無効になる。
+ * 確保した領域はResetFrame()後も保持され、次のフレームで再利用される。
+ *
+ * 使用例:
+ * @code
+ *   auto& commands = TransientSlotSystem<DrawCommand>::GetInstance();
+ *   SlotHandle h = commands.Create(DrawCommand{ mesh, transform });
+ *   commands.ForEach([](SlotHandle, DrawCommand& cmd) { Submit(cmd); });
+ *   commands.ResetFrame();
+ * @endcode
+ *
+ * @tparam T 管理する要素の型
+ */
+template<typename T>
+class TransientSlotSystem {
+public:
+    /// シングルトンインスタンスを取得
+    static TransientSlotSystem& GetInstance() {
+        static TransientSlotSystem instance;
+        return instance;
+    }
+
+    /**
+     * @brief 新しい要素を作成
+     *
+     * @param obj 追加する要素 (ムーブされる)
+     * @return 作成された要素のハンドル（現在のフレームの間だけ有効）
+     */
+    SlotHandle Create(T&& obj) {
+        return Emplace(std::move(obj));
+    }
+
+    /**
+     * @brief 引数を転送して新しい要素を末尾に直接構築
+     *
+     * @return 作成された要素のハンドル（現在のフレームの間だけ有効）
+     */
+    template<typename... Args>
+    SlotHandle Emplace(Args&&... args) {
+        SlotHandle handle{ static_cast<uint32_t>(m_data.size()), m_frame };
+        m_data.emplace_back(std::forward<Args>(args)...);
+        return handle;
+    }
+
+    /// ハンドルが現在のフレームの要素を指しているか検証
+    bool IsValidHandle(SlotHandle handle) const {
+        return handle.generation == m_frame && handle.index < m_data.size();
+    }
+
+    /// ハンドルから要素を取得（前のフレームのハンドルならnullptr）
+    T* Get(SlotHandle handle) {
+        if (!IsValidHandle(handle)) return nullptr;
+        return &m_data.get(handle.index);
+    }
+
+    /// ハンドルから要素を取得 (const版)
+    const T* Get(SlotHandle handle) const {
+        if (!IsValidHandle(handle)) return nullptr;
+        return &m_data.get(handle.index);
+    }
+
+    /**
+     * @brief 現在のフレームの全要素に対して作成順に処理を実行
+     */
+    template<typename Func>
+    void ForEach(Func&& func) {
+        for (size_t i = 0; i < m_data.size(); ++i) {
+            func(SlotHandle{ static_cast<uint32_t>(i), m_frame }, m_data.get(i));
+        }
+    }
+
+    /**
+     * @brief 現在のフレームの全要素に対して作成順に処理を実行 (const版)
+     */
+    template<typename Func>
+    void ForEach(Func&& func) const {
+        for (size_t i = 0; i < m_data.size(); ++i) {
+            func(SlotHandle{ static_cast<uint32_t>(i), m_frame }, m_data.get(i));
+        }
+    }
+
+    /**
+     * @brief 現在のフレームの全要素を破棄し、フレーム番号を進める
+     *
+     * トリビアルに破棄可能な型では要素数を0に戻すだけで完了する。
+     * 確保済みのメモリは解放しない。
+     */
+    void ResetFrame() {
+        m_data.clear();
+        ++m_frame;
+    }
+
+    /// 現在のフレーム番号を取得
+    uint32_t GetFrame() const { return m_frame; }
+
+    /// 現在のフレームの要素数を取得
+    size_t Count() const { return m_data.size(); }
+
+    /// 要素配列の先頭アドレスを取得
+    T* Data() { return m_data.data(); }
+
+    /// 要素配列の先頭アドレスを取得 (const版)
+    const T* Data() const { return m_data.data(); }
+
+    /// 1フレームで使う要素数分のメモリを事前確保
+    void Reserve(size_t capacity) { m_data.reserve(capacity); }
+
+    // コピー・ムーブ禁止
+    TransientSlotSystem(const TransientSlotSystem&) = delete;
+    TransientSlotSystem& operator=(const TransientSlotSystem&) = delete;
+    TransientSlotSystem(TransientSlotSystem&&) = delete;
+    TransientSlotSystem& operator=(TransientSlotSystem&&) = delete;
+
+private:
+    TransientSlotSystem() = default;
+    ~TransientSlotSystem() = default;
+
+    /** 要素の連続配置ストレージ（末尾に積むだけで確保する） */
+    root_vector<T> m_data;
+
+    /** 現在のフレーム番号（ハンドルの世代番号として使う） */
+    uint32_t m_frame = 0;
+};
\ No newline at end of file
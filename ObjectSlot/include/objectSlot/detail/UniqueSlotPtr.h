@@ -0,0 +1,189 @@
+#pragma once
+
+#include "ObjectSlotSystemBase.h"
+#include "SlotPtr.h"
+#include "thirdparty/rootVector/RootVector.h"
+#include <cstddef>
+
+// 前方宣言
+template<typename T>
+class ObjectSlotSystem;
+
+/**
+ * @brief 所有者が1つだけのプール要素を指すムーブ専用のスマートポインタ
+ *
+ * ObjectSlotSystem::CreateUnique()で作成する。
+ * 所有権の移動は参照カウントに一切触れず、破棄時に参照カウントを1つ減らす。プールはシングルトンから取得するため、
+ * 中身はroot_pointerのみで、ネイティブ環境では生ポインタと同じ8バイトになる。
+ *
+ * 共有が必要になったら、ムーブでSlotPtrに変換できる。
+ * @code
+ *   UniqueSlotPtr<Mesh> unique = ObjectSlotSystem<Mesh>::GetInstance().CreateUnique(Mesh{ "Box" });
+ *   SlotPtr<Mesh> shared = std::move(unique);
+ * @endcode
+ *
+ * 要素の参照カウントは作成時の1のまま保たれる。弱参照からLock()したSlotPtr等で
+ * 一時的に共有でき、UniqueSlotPtrの破棄時に他の参照が残っていれば、最後の参照が外れたときに削除される。
+ *
+ * @tparam T プール内で管理される要素の型
+ */
+template<typename T>
+class UniqueSlotPtr {
+    friend class SlotPtr<T>;
+    friend class ObjectSlotSystem<T>;
+
+public:
+    /// デフォルトコンストラクタ
+    UniqueSlotPtr()
+        : m_root_ptr()
+    {
+    }
+
+    /// nullptrからの構築
+    UniqueSlotPtr(std::nullptr_t)
+        : m_root_ptr()
+    {
+    }
+
+    // コピー禁止
+    UniqueSlotPtr(const UniqueSlotPtr&) = delete;
+    UniqueSlotPtr& operator=(const UniqueSlotPtr&) = delete;
+
+    /// ムーブコンストラクタ（参照カウントに触れない）
+    UniqueSlotPtr(UniqueSlotPtr&& other) noexcept
+        : m_root_ptr(other.m_root_ptr)
+    {
+        other.m_root_ptr.reset();
+    }
+
+    /// ムーブ代入演算子（参照カウントに触れない）
+    UniqueSlotPtr& operator=(UniqueSlotPtr&& other) noexcept {
+        if (this != &other) {
+            Destroy();
+            m_root_ptr = other.m_root_ptr;
+            other.m_root_ptr.reset();
+        }
+        return *this;
+    }
+
+    /// nullptr代入演算子
+    UniqueSlotPtr& operator=(std::nullptr_t) noexcept {
+        Reset();
+        return *this;
+    }
+
+    /// デストラクタ
+    ~UniqueSlotPtr() {
+        Destroy();
+    }
+
+    /// アロー演算子（ゼロコスト）
+    T* operator->() { return m_root_ptr.get(); }
+
+    /// アロー演算子 (const版)
+    const T* operator->() const { return m_root_ptr.get(); }
+
+    /// 間接参照演算子
+    T& operator*() { return *m_root_ptr; }
+
+    /// 間接参照演算子 (const版)
+    const T& operator*() const { return *m_root_ptr; }
+
+    /// 要素へのポインタを取得（ゼロコスト）
+    T* Get() { return m_root_ptr.get(); }
+
+    /// 要素へのポインタを取得（ゼロコスト、const版）
+    const T* Get() const { return m_root_ptr.get(); }
+
+    /// 参照が有効かどうかを判定
+    bool IsValid() const {
+        return static_cast<bool>(m_root_ptr);
+    }
+
+    /// bool変換演算子
+    explicit operator bool() const { return IsValid(); }
+
+    /// 要素を破棄して空にする
+    void Reset() {
+        Destroy();
+        m_root_ptr.reset();
+    }
+
+    /// 別のUniqueSlotPtrと内容を交換
+    void Swap(UniqueSlotPtr& other) noexcept {
+        std::swap(m_root_ptr, other.m_root_ptr);
+    }
+
+    /// ハンドルを取得（インデックスからハンドルを再構築する）
+    SlotHandle GetHandle() const {
+        if (!IsValid()) return SlotHandle::Invalid();
+        return Pool().HandleFromIndex(GetIndex());
+    }
+
+    /// 弱参照を生成
+    WeakSlotPtr<T> GetWeak() const {
+        if (!IsValid()) return WeakSlotPtr<T>();
+        return WeakSlotPtr<T>(GetHandle(), &Pool());
+    }
+
+    /// nullptrとの等価比較
+    bool operator==(std::nullptr_t) const noexcept { return !IsValid(); }
+
+    /// nullptrとの非等価比較
+    bool operator!=(std::nullptr_t) const noexcept { return IsValid(); }
+
+private:
+    /// 作成直後の要素を指すroot_pointerから構築（ObjectSlotSystem用）
+    explicit UniqueSlotPtr(typename root_vector<T>::root_pointer ptr)
+        : m_root_ptr(ptr)
+    {
+    }
+
+    /// 要素が属するプール（型ごとのシングルトン）
+    static ObjectSlotSystemBase<T>& Pool() {
+        return ObjectSlotSystem<T>::GetInstance();
+    }
+
+    /// スロットインデックスをポインタ演算で算出
+    uint32_t GetIndex() const {
+        return static_cast<uint32_t>(m_root_ptr.get() - Pool().DataPtr());
+    }
+
+    /// 所有権を手放してroot_pointerを返す（SlotPtrへの変換用）
+    typename root_vector<T>::root_pointer Detach() {
+        auto ptr = m_root_ptr;
+        m_root_ptr.reset();
+        return ptr;
+    }
+
+    /**
+     * @brief 所有権を手放す
+     *
+     * 参照カウントを1つ減らし、他の参照が残っていなければ要素を削除する。
+     */
+    void Destroy() {
+        if (m_root_ptr) {
+            Pool().ReleaseRefByIndex(GetIndex());
+        }
+    }
+
+    /** 要素への安定ポインタ */
+    typename root_vector<T>::root_pointer m_root_ptr;
+};
+
+template<typename T>
+bool operator==(std::nullptr_t, const UniqueSlotPtr<T>& rhs) noexcept { return rhs == nullptr; }
+
+template<typename T>
+bool operator!=(std::nullptr_t, const UniqueSlotPtr<T>& rhs) noexcept { return rhs != nullptr; }
+
+/// ADL用swap関数
+template<typename T>
+void swap(UniqueSlotPtr<T>& lhs, UniqueSlotPtr<T>& rhs) noexcept { lhs.Swap(rhs); }
+
+template<typename T>
+SlotPtr<T>::SlotPtr(UniqueSlotPtr<T>&& other)
+    : m_root_ptr(other.Detach())
+    , m_slot(m_root_ptr ? &UniqueSlotPtr<T>::Pool() : nullptr)
+{
+}
\ No newline at end of file
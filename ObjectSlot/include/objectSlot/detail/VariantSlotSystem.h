@@ -0,0 +1,329 @@
+#pragma once
+
+#include "SlotControlBase.h"
+#include "SlotRef.h"
+#include "thirdparty/rootVector/RootVector.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief 複数の具体型を1つの連続配列に格納するオブジェクトプール
+ *
+ * 具体型ごとにプールを分ける代わりに、タグ付きのスロット（std::variantに近い形）を
+ * 1つのroot_vectorに並べて管理する。型の異なる要素も作成順に隣り合って配置されるため、
+ * 挿入順の局所性を保ったまま混在したコレクションを扱える。
+ *
+ * Create()はSlotRef<U>を返し、共通の基底型のSlotRef<Base>にそのまま変換できる。
+ *
+ * 走査方法:
+ * - ForEach(): スロット順（作成順に近い順序）に走査し、タグで分岐して具体型を渡す
+ * - Visit(): 一度の走査でタグごとにバケット分けしてから、具体型ごとにまとめて呼び出す。
+ *   同じ型の呼び出しが連続するため、分岐予測と仮想関数の呼び出し先が安定する
+ *
+ * ObjectSlotSystemと同様、ネイティブ環境では要素のアドレスが不変であることを前提に
+ * SlotRefの生ポインタを保持する。フォールバック環境では再アロケーション時に
+ * SlotRefのポインタは更新されないため、事前にReserve()で容量を確保すること。
+ *
+ * 使用例:
+ * @code
+ *   auto& pool = VariantSlotSystem<Mesh, Sprite>::GetInstance();
+ *   SlotRef<IDrawable> mesh = pool.Create(Mesh{ "Box" });
+ *   pool.Visit([](SlotHandle, auto& drawable) { drawable.Draw(); });
+ * @endcode
+ *
+ * @tparam Types 格納する具体型（最大254種類）
+ */
+template<typename... Types>
+class VariantSlotSystem : public SlotControlBase {
+    static_assert(sizeof...(Types) > 0, "VariantSlotSystemには1つ以上の型を指定してください。");
+    static_assert(sizeof...(Types) < 255, "VariantSlotSystemに指定できる型は254種類までです。");
+
+public:
+    /** 型の数 */
+    static constexpr size_t TypeCount = sizeof...(Types);
+
+    /** 空きスロットを表すタグ */
+    static constexpr uint8_t NO_TAG = 0xFF;
+
+    /// 型のタグ（Typesでの位置）を取得
+    template<typename U>
+    static constexpr uint8_t TagOf() {
+        static_assert((std::is_same_v<U, Types> || ...), "VariantSlotSystemに含まれない型です。");
+        uint8_t tag = 0;
+        bool found = false;
+        ((found = found || std::is_same_v<U, Types>, tag += found ? 0 : 1), ...);
+        return tag;
+    }
+
+    /// シングルトンインスタンスを取得
+    static VariantSlotSystem& GetInstance() {
+        static VariantSlotSystem instance;
+        return instance;
+    }
+
+    /**
+     * @brief 新しい要素を作成
+     *
+     * 空きスロットがあれば再利用し、なければ末尾に追加する。
+     *
+     * @tparam U 作成する要素の型（Typesのいずれか）
+     * @param obj 追加する要素 (ムーブされる)
+     * @return 作成された要素へのSlotRef（参照カウント = 1）
+     */
+    template<typename U, std::enable_if_t<!std::is_lvalue_reference_v<U>, int> = 0>
+    SlotRef<U> Create(U&& obj) {
+        constexpr uint8_t tag = TagOf<U>();
+        if (!this->PrepareCreate()) return SlotRef<U>();
+
+        uint32_t index;
+        if (!m_freeList.empty()) {
+            index = m_freeList.front();
+            m_freeList.pop_front();
+            m_alive[index] = true;
+            m_refCounts[index] = 0;
+        }
+        else {
+            index = static_cast<uint32_t>(m_data.size());
+            m_data.push_back(Slot{});
+            m_generations.push_back(InitialGeneration());
+            m_alive.push_back(true);
+            m_refCounts.push_back(0);
+        }
+
+        Slot& slot = m_data.get(index);
+        U* object = new (slot.storage) U(std::move(obj));
+        slot.tag = tag;
+
+        ++m_refCounts[index];
+        ++m_count;
+        return SlotRef<U>(object, this, index);
+    }
+
+    /**
+     * @brief ハンドルから要素を取得
+     *
+     * @return ハンドルが有効で要素の型がUの場合はそのポインタ、それ以外はnullptr
+     */
+    template<typename U>
+    U* Get(SlotHandle handle) {
+        if (!IsValidHandle(handle)) return nullptr;
+        Slot& slot = m_data.get(handle.index);
+        if (slot.tag != TagOf<U>()) return nullptr;
+        return slot.template As<U>();
+    }
+
+    /// ハンドルが指す要素の型タグを取得（無効ならNO_TAG）
+    uint8_t GetTag(SlotHandle handle) const {
+        if (!IsValidHandle(handle)) return NO_TAG;
+        return m_data.get(handle.index).tag;
+    }
+
+    /// プール内の要素へのポインタからハンドルを取得
+    SlotHandle GetHandle(const void* object) const {
+        uint32_t index = IndexFromRawPtr(const_cast<void*>(object));
+        if (index >= m_alive.size() || !m_alive[index]) return SlotHandle::Invalid();
+        return HandleFromIndex(index);
+    }
+
+    /**
+     * @brief 全ての有効な要素をスロット順に処理する
+     *
+     * @param func func(SlotHandle, U&) の形で全ての型について呼べる関数（通常はジェネリックラムダ）
+     */
+    template<typename Func>
+    void ForEach(Func&& func) {
+        for (size_t i = 0; i < m_data.size(); ++i) {
+            if (m_alive[i]) {
+                SlotHandle h{ static_cast<uint32_t>(i), m_generations[i] };
+                Dispatch(m_data.get(i), h, func, std::index_sequence_for<Types...>{});
+            }
+        }
+    }
+
+    /**
+     * @brief 全ての有効な要素を型ごとにまとめて処理する
+     *
+     * スロット配列を一度走査してタグごとのインデックスをバケットに集め、
+     * Typesの順に同じ型の要素を連続して呼び出す。各型の中ではスロット順になる。
+     * バケットは使い回すため、Visitの中から同じプールのVisitを呼ばないこと。
+     *
+     * @param func func(SlotHandle, U&) の形で全ての型について呼べる関数（通常はジェネリックラムダ）
+     */
+    template<typename Func>
+    void Visit(Func&& func) {
+        assert(!m_visiting && "Visit中に同じプールのVisitは呼べません。");
+        m_visiting = true;
+
+        for (auto& bucket : m_buckets) {
+            bucket.clear();
+        }
+        for (size_t i = 0; i < m_data.size(); ++i) {
+            if (m_alive[i]) {
+                m_buckets[m_data.get(i).tag].push_back(static_cast<uint32_t>(i));
+            }
+        }
+        VisitBuckets(func, std::index_sequence_for<Types...>{});
+
+        m_visiting = false;
+    }
+
+    /**
+     * @brief プール内の全要素を削除
+     */
+    void Clear() {
+        m_data.clear();
+        AdvanceEpoch();
+        m_generations.clear();
+        m_alive.clear();
+        m_refCounts.clear();
+        m_freeList.clear();
+        m_count = 0;
+    }
+
+    /**
+     * @brief 指定した数の要素分のメモリを事前確保
+     */
+    void Reserve(size_t capacity) {
+        m_data.reserve(capacity);
+        m_generations.reserve(capacity);
+        m_alive.reserve(capacity);
+        m_refCounts.reserve(capacity);
+    }
+
+    /**
+     * @brief 生ポインタからスロットインデックスを算出
+     *
+     * 要素はスロットの先頭に配置されるため、基底型へのポインタでも
+     * スロット先頭からのバイトオフセットをスロットサイズで割れば求まる。
+     */
+    uint32_t IndexFromRawPtr(void* rawPtr) const override {
+        const auto* bytes = static_cast<const unsigned char*>(rawPtr);
+        const auto* base = reinterpret_cast<const unsigned char*>(m_data.data());
+        return static_cast<uint32_t>(static_cast<size_t>(bytes - base) / sizeof(Slot));
+    }
+
+    // コピー・ムーブ禁止
+    VariantSlotSystem(const VariantSlotSystem&) = delete;
+    VariantSlotSystem& operator=(const VariantSlotSystem&) = delete;
+    VariantSlotSystem(VariantSlotSystem&&) = delete;
+    VariantSlotSystem& operator=(VariantSlotSystem&&) = delete;
+
+protected:
+    /**
+     * @brief 要素を削除する内部処理
+     *
+     * タグに応じたデストラクタを呼び、スロットを空きに戻す。
+     */
+    void RemoveInternal(SlotHandle handle) override {
+        m_alive[handle.index] = false;
+        AdvanceGeneration(handle.index);
+        m_refCounts[handle.index] = 0;
+
+        m_data.get(handle.index).Reset();
+
+        m_freeList.push_back(handle.index);
+        --m_count;
+    }
+
+private:
+    VariantSlotSystem() = default;
+    ~VariantSlotSystem() = default;
+
+    /** Typesのi番目の型 */
+    template<size_t I>
+    using TypeAt = std::tuple_element_t<I, std::tuple<Types...>>;
+
+    /**
+     * @brief タグ付きスロット
+     *
+     * 要素を先頭に配置し、その後ろに型タグを持つ。
+     * 空きスロットのタグはNO_TAGで、破棄済みの要素を二重に破棄しない。
+     */
+    struct Slot {
+        /** 要素の配置先（全ての型を格納できるサイズとアライメント） */
+        alignas(Types...) unsigned char storage[std::max({ sizeof(Types)... })];
+
+        /** 格納中の要素の型タグ */
+        uint8_t tag = NO_TAG;
+
+        Slot() = default;
+
+        /// 再アロケーション時の移動（タグに応じてムーブ構築する）
+        Slot(Slot&& other) noexcept
+            : tag(other.tag)
+        {
+            if (tag != NO_TAG) {
+                MoveFrom(other, std::index_sequence_for<Types...>{});
+            }
+        }
+
+        Slot(const Slot&) = delete;
+        Slot& operator=(const Slot&) = delete;
+        Slot& operator=(Slot&&) = delete;
+
+        ~Slot() { Reset(); }
+
+        /// 格納中の要素をUとして取得
+        template<typename U>
+        U* As() { return std::launder(reinterpret_cast<U*>(storage)); }
+
+        /// 格納中の要素を破棄して空きにする
+        void Reset() {
+            if (tag != NO_TAG) {
+                DestroyAs(std::index_sequence_for<Types...>{});
+                tag = NO_TAG;
+            }
+        }
+
+    private:
+        template<size_t... I>
+        void MoveFrom(Slot& other, std::index_sequence<I...>) {
+            ((tag == I ? (new (storage) TypeAt<I>(std::move(*other.template As<TypeAt<I>>())), true) : false) || ...);
+        }
+
+        template<size_t... I>
+        void DestroyAs(std::index_sequence<I...>) {
+            ((tag == I ? (std::destroy_at(As<TypeAt<I>>()), true) : false) || ...);
+        }
+    };
+
+    /// タグに応じた具体型で関数を呼び出す
+    template<typename Func, size_t... I>
+    static void Dispatch(Slot& slot, SlotHandle handle, Func& func, std::index_sequence<I...>) {
+        ((slot.tag == I ? (func(handle, *slot.template As<TypeAt<I>>()), true) : false) || ...);
+    }
+
+    /// 全てのバケットを型の順に処理する
+    template<typename Func, size_t... I>
+    void VisitBuckets(Func& func, std::index_sequence<I...>) {
+        (VisitBucket<I>(func), ...);
+    }
+
+    /// 1つの型のバケットを処理する（呼び出し先の型が静的に決まる）
+    template<size_t I, typename Func>
+    void VisitBucket(Func& func) {
+        for (uint32_t index : m_buckets[I]) {
+            // 呼び出し中に削除（または別の型で再利用）された要素は飛ばす
+            Slot& slot = m_data.get(index);
+            if (!m_alive[index] || slot.tag != I) continue;
+            SlotHandle h{ index, m_generations[index] };
+            func(h, *slot.template As<TypeAt<I>>());
+        }
+    }
+
+    /** タグ付きスロットの連続配置ストレージ */
+    root_vector<Slot> m_data;
+
+    /** Visit用のタグごとのインデックスバケット（使い回す） */
+    std::array<std::vector<uint32_t>, TypeCount> m_buckets;
+
+    /** Visit実行中かどうか */
+    bool m_visiting = false;
+};
\ No newline at end of file
@@ -196,6 +196,16 @@ public:
         return Subscription<T>(m_slot, m_handle.index, id);
     }
 
+#if defined(__cpp_impl_coroutine)
+    /**
+     * @brief 要素の解放をco_awaitで待つためのAwaiterを取得
+     *
+     * 要素が解放され、購読者への通知が完了した後にコルーチンが再開される。
+     * 既に期限切れの場合は中断せずに進む。
+     */
+    ReleaseAwaiter<T> Released() const;
+#endif
+
     /// 弱参照をリセット
     void Reset()
     {
@@ -506,6 +506,12 @@ public:
 	/// 要素が空かどうか
 	bool empty() const { return m_size == 0; }
 
+	/// 物理メモリをコミット済みのバイト数
+	size_t committed_bytes() const { return m_committed_bytes; }
+
+	/// 予約済みの仮想アドレス空間のバイト数
+	size_t reserved_bytes() const { return m_reserved_bytes; }
+
 	/// 指定した要素数分の容量を確保する
 	void reserve(size_type count)
 	{
@@ -513,6 +519,29 @@ public:
 		ensure_committed(count);
 	}
 
+	/**
+	 * @brief 容量を確保し、未使用領域のページを事前に割り当てる
+	 *
+	 * reserve()に加えて、コミットした領域のうち要素が入っていないページに書き込み、
+	 * 最初の要素追加時に発生するページフォルトを前もって済ませる。
+	 * フォールバック環境ではreserve()と同じ。
+	 *
+	 * @param count 確保する要素数
+	 */
+	void reserve_prefaulted(size_type count)
+	{
+		reserve(count);
+#if defined(ROOT_VECTOR_STABLE_ADDRESS)
+		const size_t page_size = virtual_memory_allocator::get_page_size();
+		const size_t used_bytes = (m_size * sizeof(T) + page_size - 1) & ~(page_size - 1);
+		char* base = reinterpret_cast<char*>(m_base_ptr);
+		for (size_t offset = used_bytes; offset < m_committed_bytes; offset += page_size)
+		{
+			*static_cast<volatile char*>(base + offset) = 0;
+		}
+#endif
+	}
+
 	/**
 	 * @brief 使用中の要素数に合わせてコミット済みメモリを縮小する
 	 *
@@ -720,6 +749,36 @@ public:
 		m_size = 0;
 	}
 
+	/**
+	 * @brief 要素の破棄とメモリの解放を行わずに空の状態にする
+	 *
+	 * プロセス終了時など、OSがまとめてメモリを回収する場面で後片付けを省くために使う。
+	 * 構築済みの要素のデストラクタは呼ばれず、確保していた領域も解放されずに残る。
+	 */
+	void abandon()
+	{
+		m_base_ptr        = nullptr;
+		m_size            = 0;
+		m_committed_bytes = 0;
+		m_reserved_bytes  = 0;
+#if !defined(ROOT_VECTOR_STABLE_ADDRESS)
+		m_ptr_table       = nullptr;
+		m_table_capacity  = 0;
+#endif
+	}
+
+	/**
+	 * @brief デストラクタを呼ばずにサイズを縮める
+	 *
+	 * 呼び出し側で既に破棄した要素を切り捨てるために使う。
+	 * 指定位置以降の要素は構築されていないものとして扱われる。
+	 */
+	void truncate_destroyed(size_type new_size)
+	{
+		assert(new_size <= m_size && "truncate_destroyed()で要素数は増やせません。");
+		m_size = new_size;
+	}
+
 	// ================================================================
 	// サイズ変更
 	// ================================================================
@@ -73,6 +73,15 @@ public:
 
 	/// OSの確保粒度を取得（グローバルキャッシュから返す）
 	static inline size_t get_allocation_granularity();
+
+	/// コミット済み領域の一部を近いうちに読むことをOSに助言する（先読み）
+	static inline void advise_will_need(void* base_address, size_t offset_bytes, size_t size_bytes);
+
+	/// コミット済み領域の一部をしばらく読まないことをOSに助言する（内容は保持される）
+	static inline void advise_cold(void* base_address, size_t offset_bytes, size_t size_bytes);
+
+	/// コミット済み領域の一部の内容を破棄して物理メモリを返却する（アドレスはアクセス可能なまま）
+	static inline void discard(void* base_address, size_t offset_bytes, size_t size_bytes);
 };
 
 
@@ -231,6 +240,76 @@ inline size_t virtual_memory_allocator::get_allocation_granularity()
 	return g_allocation_granularity;
 }
 
+/**
+ * @brief 指定範囲の先読みを助言する（Windows版）
+ *
+ * PrefetchVirtualMemory（Windows 8以降）で範囲のページをまとめて読み込ませる。
+ * 対応していないSDKでビルドした場合は何もしない。
+ *
+ * @param base_address reserve()で取得した先頭アドレス
+ * @param offset_bytes 範囲の先頭（先頭アドレスからのバイト数）
+ * @param size_bytes 範囲のバイト数
+ */
+inline void virtual_memory_allocator::advise_will_need(void* base_address, size_t offset_bytes, size_t size_bytes)
+{
+#if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+	if (size_bytes == 0) return;
+	WIN32_MEMORY_RANGE_ENTRY range;
+	range.VirtualAddress = static_cast<char*>(base_address) + offset_bytes;
+	range.NumberOfBytes = size_bytes;
+	::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0);
+#else
+	(void)base_address;
+	(void)offset_bytes;
+	(void)size_bytes;
+#endif
+}
+
+/**
+ * @brief 指定範囲をしばらく読まないことを助言する（Windows版）
+ *
+ * ロックされていないページに対するVirtualUnlockは、
+ * 内容を保持したままページをワーキングセットから外す。
+ * （ロックされていないため関数自体は失敗を返すが、それが目的の動作である）
+ *
+ * @param base_address reserve()で取得した先頭アドレス
+ * @param offset_bytes 範囲の先頭（先頭アドレスからのバイト数）
+ * @param size_bytes 範囲のバイト数
+ */
+inline void virtual_memory_allocator::advise_cold(void* base_address, size_t offset_bytes, size_t size_bytes)
+{
+	if (size_bytes == 0) return;
+	::VirtualUnlock(static_cast<char*>(base_address) + offset_bytes, size_bytes);
+}
+
+/**
+ * @brief 指定範囲の内容を破棄して物理メモリを返却する（Windows版）
+ *
+ * VirtualAlloc(MEM_RESET)で、ページの内容が不要になったことをOSに伝える。
+ * ページはコミットされたままで、次に書き込むまで物理メモリやページファイルを使わない。
+ * 破棄後の内容は不定なので、再利用前に必ず書き込むこと。
+ *
+ * 範囲の途中にあるページだけを対象にするため、ページ境界に狭める。
+ *
+ * @param base_address reserve()で取得した先頭アドレス
+ * @param offset_bytes 範囲の先頭（先頭アドレスからのバイト数）
+ * @param size_bytes 範囲のバイト数
+ */
+inline void virtual_memory_allocator::discard(void* base_address, size_t offset_bytes, size_t size_bytes)
+{
+	const size_t page_size = g_page_size;
+
+	const size_t aligned_start = (offset_bytes + page_size - 1) & ~(page_size - 1);
+	const size_t aligned_end   = (offset_bytes + size_bytes) & ~(page_size - 1);
+
+	if (aligned_start >= aligned_end)
+	{
+		return;
+	}
+
+	::VirtualAlloc(static_cast<char*>(base_address) + aligned_start, aligned_end - aligned_start, MEM_RESET, PAGE_READWRITE);
+}
+
 
 // ============================================================
 // Linux / macOS 実装 (POSIX)
@@ -377,6 +456,94 @@ inline size_t virtual_memory_allocator::get_allocation_granularity()
 	return get_page_size();
 }
 
+/**
+ * @brief 指定範囲の先読みを助言する（POSIX版）
+ *
+ * madvise(MADV_WILLNEED)で、スワップアウトされたページの読み込みを先に始めさせる。
+ * 範囲はページ境界に広げる。
+ *
+ * @param base_address reserve()で取得した先頭アドレス
+ * @param offset_bytes 範囲の先頭（先頭アドレスからのバイト数）
+ * @param size_bytes 範囲のバイト数
+ */
+inline void virtual_memory_allocator::advise_will_need(void* base_address, size_t offset_bytes, size_t size_bytes)
+{
+	const size_t page_size = g_page_size;
+
+	const size_t aligned_start = offset_bytes & ~(page_size - 1);
+	const size_t aligned_end   = (offset_bytes + size_bytes + page_size - 1) & ~(page_size - 1);
+
+	if (aligned_start >= aligned_end)
+	{
+		return;
+	}
+
+	::madvise(static_cast<char*>(base_address) + aligned_start, aligned_end - aligned_start, MADV_WILLNEED);
+}
+
+/**
+ * @brief 指定範囲をしばらく読まないことを助言する（POSIX版）
+ *
+ * madvise(MADV_COLD)（Linux 5.4以降）でページを回収の優先候補に回す。
+ * 内容は保持され、再びアクセスすれば（必要ならスワップから）読み戻される。
+ * 匿名メモリに対するMADV_DONTNEEDは内容を破棄してしまうため使わない。
+ * MADV_COLDがない環境では何もしない。
+ *
+ * 範囲の途中にあるページだけを対象にするため、ページ境界に狭める。
+ *
+ * @param base_address reserve()で取得した先頭アドレス
+ * @param offset_bytes 範囲の先頭（先頭アドレスからのバイト数）
+ * @param size_bytes 範囲のバイト数
+ */
+inline void virtual_memory_allocator::advise_cold(void* base_address, size_t offset_bytes, size_t size_bytes)
+{
+#if defined(MADV_COLD)
+	const size_t page_size = g_page_size;
+
+	const size_t aligned_start = (offset_bytes + page_size - 1) & ~(page_size - 1);
+	const size_t aligned_end   = (offset_bytes + size_bytes) & ~(page_size - 1);
+
+	if (aligned_start >= aligned_end)
+	{
+		return;
+	}
+
+	::madvise(static_cast<char*>(base_address) + aligned_start, aligned_end - aligned_start, MADV_COLD);
+#else
+	(void)base_address;
+	(void)offset_bytes;
+	(void)size_bytes;
+#endif
+}
+
+/**
+ * @brief 指定範囲の内容を破棄して物理メモリを返却する（POSIX版）
+ *
+ * madvise(MADV_DONTNEED)で物理ページを解放する。
+ * アクセス権はそのままで、次にアクセスしたときにゼロで埋めたページが割り当てられる。
+ * decommitと違い、範囲の途中（使用中の領域の内側）にも使える。
+ *
+ * 範囲の途中にあるページだけを対象にするため、ページ境界に狭める。
+ *
+ * @param base_address reserve()で取得した先頭アドレス
+ * @param offset_bytes 範囲の先頭（先頭アドレスからのバイト数）
+ * @param size_bytes 範囲のバイト数
+ */
+inline void virtual_memory_allocator::discard(void* base_address, size_t offset_bytes, size_t size_bytes)
+{
+	const size_t page_size = g_page_size;
+
+	const size_t aligned_start = (offset_bytes + page_size - 1) & ~(page_size - 1);
+	const size_t aligned_end   = (offset_bytes + size_bytes) & ~(page_size - 1);
+
+	if (aligned_start >= aligned_end)
+	{
+		return;
+	}
+
+	::madvise(static_cast<char*>(base_address) + aligned_start, aligned_end - aligned_start, MADV_DONTNEED);
+}
+
 
 // ============================================================
 // フォールバック実装 (Emscripten等、仮想メモリ非対応環境)
@@ -470,4 +637,36 @@ inline size_t virtual_memory_allocator::get_allocation_granularity()
 	return g_allocation_granularity;
 }
 
+/**
+ * @brief 先読みの助言（フォールバック版、何もしない）
+ */
+inline void virtual_memory_allocator::advise_will_need(
+	[[maybe_unused]] void* base_address,
+	[[maybe_unused]] size_t offset_bytes,
+	[[maybe_unused]] size_t size_bytes)
+{
+}
+
+/**
+ * @brief 非アクセスの助言（フォールバック版、何もしない）
+ */
+inline void virtual_memory_allocator::advise_cold(
+	[[maybe_unused]] void* base_address,
+	[[maybe_unused]] size_t offset_bytes,
+	[[maybe_unused]] size_t size_bytes)
+{
+}
+
+/**
+ * @brief 内容の破棄（フォールバック版、何もしない）
+ *
+ * mallocで確保したメモリはページ単位で返却できないため、何もしない。
+ */
+inline void virtual_memory_allocator::discard(
+	[[maybe_unused]] void* base_address,
+	[[maybe_unused]] size_t offset_bytes,
+	[[maybe_unused]] size_t size_bytes)
+{
+}
+
 #endif
\ No newline at end of file
@@ -9,6 +9,13 @@
 #include <chrono>
 #include <memory>
 #include <numeric>
+#include <thread>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <filesystem>
+#include <cstring>
+#include <stdexcept>
 
 // ======================================================
 // テスト用の型定義
@@ -32,6 +39,8 @@ public:
     Mesh(const std::string& n, int v) : name(n), vertexCount(v) {}
     void Draw() const override { std::cout << "  メッシュ描画: " << name << std::endl; }
     const std::string& GetName() const override { return name; }
+    template<class Archive>
+    void Serialize(Archive& ar) { ar(name, vertexCount); }
 };
 
 /// IDrawableの具体型B
@@ -56,6 +65,102 @@ struct Buffer {
     void Release() { std::cout << "  " << name << " を解放しました" << std::endl; }
 };
 
+/// バックグラウンド破棄テスト用：破棄に時間のかかるメッシュ
+struct HeavyMesh {
+    std::vector<float> vertices;
+    static inline std::thread::id destroyedOn;
+    static inline int destroyedCount = 0;
+    HeavyMesh(std::vector<float> v) : vertices(std::move(v)) {}
+    HeavyMesh(HeavyMesh&&) = default;
+    HeavyMesh& operator=(HeavyMesh&&) = default;
+    ~HeavyMesh() {
+        // ムーブ後の抜け殻は記録しない
+        if (!vertices.empty()) {
+            destroyedOn = std::this_thread::get_id();
+            ++destroyedCount;
+        }
+    }
+};
+
+template<>
+struct UseBackgroundDestruction<HeavyMesh> : std::true_type {};
+
+/// グラフシリアライズテスト用：マテリアル
+struct GraphMaterial {
+    std::string name;
+    float roughness = 0.0f;
+    template<class Archive>
+    void Serialize(Archive& ar) { ar(name, roughness); }
+};
+
+/// グラフシリアライズテスト用：他のプールの要素を参照するノード
+struct GraphNode {
+    std::string name;
+    std::vector<int> tags;
+    SlotPtr<GraphMaterial> material;
+    SlotPtr<GraphNode> parent;
+    SlotRef<IDrawable> drawable;
+    template<class Archive>
+    void Serialize(Archive& ar) { ar(name, tags, material, parent, drawable); }
+};
+
+/// 連鎖解放テスト用：次のノードを所有する連結リストのノード
+struct ChainNode {
+    int value = 0;
+    SlotPtr<ChainNode> next;
+};
+
+/// 循環参照の回収テスト用：互いを所有し合えるノード
+struct CycleNode {
+    CycleNode() = default;
+    explicit CycleNode(std::string n) : name(std::move(n)) {}
+
+    std::string name;
+    SlotPtr<CycleNode> next;
+    std::vector<SlotPtr<CycleNode>> children;
+    SlotPtr<GraphMaterial> material;
+    template<class Visitor>
+    void Trace(Visitor& visitor) { visitor(next, children, material); }
+};
+
+template<>
+struct HoldsSlotReferences<CycleNode> : std::true_type {};
+
+/// 予約プロファイルテスト用：プロファイルの読み込み後に初めてプールを作る型
+struct ProfiledItem {
+    uint64_t payload[8] = {};
+};
+
+/// 高速終了テスト用：破棄された数を数える要素
+struct ExitProbe {
+    static inline int destroyed = 0;
+    int value = 0;
+    ~ExitProbe() { ++destroyed; }
+};
+
+/// 高速終了テスト用：シングルトンではなく任意のタイミングで破棄できるプール
+class ExitProbePool : public ObjectSlotSystemBase<ExitProbe> {
+public:
+    void Add(int value) { AllocateSlot(ExitProbe{ value }); }
+};
+
+/// メモリ関連のテスト用：使用量が分かりやすい固定サイズの要素
+struct PayloadItem {
+    uint64_t payload[8] = {};
+};
+
+/// EnableSlotFromThisテスト用：トリビアルに破棄可能なまま自分を取得できる型
+class TrivialSelfObject : public EnableSlotFromThis<TrivialSelfObject> {
+public:
+    int value = 0;
+    TrivialSelfObject() = default;
+    explicit TrivialSelfObject(int v) : value(v) {}
+
+    SlotPtr<TrivialSelfObject> GetSelf() {
+        return SlotPtrFromThis();
+    }
+};
+
 /// EnableSlotFromThisテスト用：ObjectSlotSystem版
 class SelfAwareObject : public EnableSlotFromThis<SelfAwareObject> {
 public:
@@ -88,6 +193,28 @@ public:
     }
 };
 
+/// EnableSlotFromAddressテスト用：メンバを持たない自己参照（ObjectSlotSystem版）
+class AddressAwareNode : public EnableSlotFromAddress<AddressAwareNode> {
+public:
+    int id = 0;
+    AddressAwareNode() = default;
+    AddressAwareNode(int i) : id(i) {}
+
+    SlotPtr<AddressAwareNode> GetSelf() const { return SlotPtrFromThis(); }
+    WeakSlotPtr<AddressAwareNode> GetWeakSelf() const { return WeakSlotPtrFromThis(); }
+    SlotHandle GetSelfHandle() const { return SlotHandleFromThis(); }
+};
+
+/// EnableSlotFromAddressテスト用：メンバを持たない自己参照（SignalSlotSystem版）
+class AddressAwareDevice : public EnableSlotFromAddress<AddressAwareDevice, SignalSlotSystem> {
+public:
+    int id = 0;
+    AddressAwareDevice() = default;
+    AddressAwareDevice(int i) : id(i) {}
+
+    SignalSlotPtr<AddressAwareDevice> GetSelf() const { return SlotPtrFromThis(); }
+};
+
 /// ベンチマーク用の軽量構造体（文字列を持たない）
 struct BenchData {
     float x = 0.0f;
@@ -112,6 +239,53 @@ public:
     float GetValue() const override { return value; }
 };
 
+/// PoolGroupベンチマーク用のIBenchObjectの具体型A（final）
+class BenchObjectA final : public IBenchObject {
+public:
+    float value = 0.0f;
+    BenchObjectA(float v) : value(v) {}
+    float GetValue() const override { return value; }
+};
+
+/// PoolGroupベンチマーク用のIBenchObjectの具体型B（final）
+class BenchObjectB final : public IBenchObject {
+public:
+    float value = 0.0f;
+    BenchObjectB(float v) : value(v) {}
+    float GetValue() const override { return value * 0.5f; }
+};
+
+#if defined(__cpp_impl_coroutine)
+/// コルーチンテスト用：開始したら呼び出し側は結果を待たないタスク
+struct FireAndForget {
+    struct promise_type {
+        FireAndForget get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+/// コルーチンテスト用：デバイスの解放を待ってから作り直す
+static FireAndForget RebuildOnRelease(WeakSignalSlotPtr<Device> device, std::vector<std::string>* log,
+    SignalSlotPtr<Device>* rebuilt)
+{
+    log->push_back("待機開始");
+    co_await device.Released();
+    log->push_back(device.IsValid() ? "再開(未解放)" : "再開");
+    *rebuilt = SignalSlotSystem<Device>::GetInstance().Create(Device{ "GPU (再構築)" });
+}
+
+/// コルーチンテスト用：要素の解放を待ってから再開回数を数える
+template<typename T>
+static FireAndForget CountOnRelease(WeakSignalSlotPtr<T> weak, int* resumeCount)
+{
+    co_await weak.Released();
+    ++*resumeCount;
+}
+#endif
+
 // ======================================================
 // テスト用ヘルパー
 // ======================================================
@@ -837,6 +1011,49 @@ int main()
         PrintResult(selfOk && weakOk && countOk);
     }
 
+    PrintTest("EnableSlotFromAddress - メンバを持たずアドレスから自分を求める");
+    {
+        std::cout << "  sizeof(AddressAwareNode) = " << sizeof(AddressAwareNode)
+            << " / sizeof(SelfAwareObject) = " << sizeof(SelfAwareObject) << std::endl;
+        bool sizeOk = (sizeof(AddressAwareNode) == sizeof(int)
+            && std::is_trivially_copyable_v<AddressAwareNode>);
+
+        auto& pool = ObjectSlotSystem<AddressAwareNode>::GetInstance();
+        auto first = pool.Create(AddressAwareNode{ 1 });
+        auto ptr = pool.Create(AddressAwareNode{ 2 });
+
+        auto self = ptr->GetSelf();
+        bool selfOk = (self == ptr && ptr.UseCount() == 2 && ptr->GetSelfHandle() == ptr.GetHandle());
+        auto weakSelf = ptr->GetWeakSelf();
+        bool weakOk = (weakSelf.IsValid() && ptr.UseCount() == 2);
+
+        // プールの外のコピーからは取得できない
+        AddressAwareNode outside = *ptr;
+        bool outsideOk = (!outside.GetSelf() && !outside.GetSelfHandle().IsValid());
+
+        auto& devices = SignalSlotSystem<AddressAwareDevice>::GetInstance();
+        auto device = devices.Create(AddressAwareDevice{ 3 });
+        auto deviceSelf = device->GetSelf();
+        bool signalOk = (deviceSelf == device && device.UseCount() == 2);
+
+        PrintResult(sizeOk && selfOk && weakOk && outsideOk && signalOk);
+    }
+
+    PrintTest("EnableSlotFromThis - 仮想関数テーブルを持たず、トリビアルな破棄を保つ");
+    {
+        std::cout << "  sizeof(TrivialSelfObject) = " << sizeof(TrivialSelfObject) << std::endl;
+        bool layoutOk = (!std::is_polymorphic_v<TrivialSelfObject>
+            && std::is_trivially_destructible_v<TrivialSelfObject>
+            && sizeof(TrivialSelfObject) <= sizeof(SlotHandle) + sizeof(void*) + sizeof(int) + alignof(void*));
+
+        auto& pool = ObjectSlotSystem<TrivialSelfObject>::GetInstance();
+        auto ptr = pool.Create(TrivialSelfObject{ 5 });
+        auto self = ptr->GetSelf();
+        bool selfOk = (self == ptr && ptr.UseCount() == 2 && self->value == 5);
+
+        PrintResult(layoutOk && selfOk);
+    }
+
     // ==================================================
     PrintCategory("複合テスト");
     // ==================================================
@@ -902,6 +1119,1094 @@ int main()
         PrintResult(!nameRef.IsValid());
     }
 
+    // ==================================================
+    PrintCategory("PoolCommandBuffer");
+    // ==================================================
+
+    PrintTest("PoolCommandBuffer - ワーカースレッドで記録し同期ポイントで適用");
+    {
+        auto& slot = ObjectSlotSystem<Mesh>::GetInstance();
+        slot.Clear();
+
+        auto existing = slot.Create(Mesh{ "Existing", 1 });
+        auto doomed = slot.Create(Mesh{ "Doomed" });
+        SlotHandle existingHandle = existing.GetHandle();
+        WeakSlotPtr<Mesh> weakDoomed = doomed.GetWeak();
+
+        PoolCommandBuffer<Mesh> workerA;
+        PoolCommandBuffer<Mesh> workerB;
+        ProvisionalHandle spawned;
+        ProvisionalHandle temporary;
+
+        std::thread threadA([&]() {
+            spawned = workerA.Create(Mesh{ "Spawned" });
+            workerA.Modify(spawned, [](Mesh& m) { m.vertexCount = 8; });
+            workerA.Modify(existingHandle, [](Mesh& m) { m.vertexCount += 10; });
+        });
+        std::thread threadB([&]() {
+            temporary = workerB.Create(Mesh{ "Temporary" });
+            workerB.Release(temporary);
+            workerB.Release(std::move(doomed));
+            workerB.Modify(existingHandle, [](Mesh& m) { m.vertexCount *= 2; });
+        });
+        threadA.join();
+        threadB.join();
+
+        bool untouched = (slot.Count() == 2 && existing->vertexCount == 1 && weakDoomed.IsValid());
+
+        auto results = PoolCommandBuffer<Mesh>::ApplyAll(slot, { &workerA, &workerB });
+        auto& spawnedPtr = results[0].objects[spawned.index];
+        SlotHandle resolved = results[0].Resolve(spawned);
+
+        bool createdOk = (spawnedPtr.IsValid() && spawnedPtr->vertexCount == 8 && slot.Get(resolved) == spawnedPtr.Get());
+        bool orderOk = (existing->vertexCount == 22);
+        bool releasedOk = (!weakDoomed.IsValid() && !results[1].objects[temporary.index].IsValid());
+        std::cout << "  existing.vertexCount: " << existing->vertexCount << ", Count: " << slot.Count() << std::endl;
+
+        PrintResult(untouched && createdOk && orderOk && releasedOk && slot.Count() == 2 && workerA.IsEmpty());
+    }
+
+    // ==================================================
+    PrintCategory("StaticSlotSystem");
+    // ==================================================
+
+    PrintTest("StaticSlotSystem - 固定容量・ハンドルサイズ・世代チェック");
+    {
+        static_assert(sizeof(StaticSlotHandle<4>) == 4, "N <= 65535 のハンドルは4バイト");
+        static_assert(sizeof(StaticSlotHandle<100000>) == 8, "N > 65535 のハンドルは8バイト");
+
+        StaticSlotSystem<Mesh, 4> scratch;
+        auto a = scratch.Create(Mesh{ "A", 1 });
+        auto b = scratch.Create(Mesh{ "B", 2 });
+        scratch.Emplace(Mesh{ "C", 3 });
+        scratch.Emplace(Mesh{ "D", 4 });
+        auto overflow = scratch.Create(Mesh{ "E", 5 });
+
+        bool fullOk = (scratch.IsFull() && !overflow.IsValid() && scratch.Count() == 4);
+
+        scratch.Destroy(b);
+        auto reused = scratch.Create(Mesh{ "F", 6 });
+        bool reuseOk = (reused.index == b.index && scratch.Get(b) == nullptr
+            && scratch.Get(reused)->vertexCount == 6 && scratch.Get(a)->name == "A");
+
+        int total = 0;
+        scratch.ForEach([&](StaticSlotSystem<Mesh, 4>::Handle, const Mesh& m) { total += m.vertexCount; });
+        std::cout << "  vertexCount合計: " << total << ", Count: " << scratch.Count() << std::endl;
+
+        scratch.Clear();
+        PrintResult(fullOk && reuseOk && total == 14 && scratch.Count() == 0 && scratch.Get(a) == nullptr);
+    }
+
+    PrintTest("StaticSlotSystem - コンストラクタが例外を投げてもスロットを失わない");
+    {
+        struct ThrowingItem {
+            int value = 0;
+            explicit ThrowingItem(int v) : value(v) {
+                if (v < 0) throw std::runtime_error("negative");
+            }
+        };
+
+        StaticSlotSystem<ThrowingItem, 2> scratch;
+        auto a = scratch.Emplace(1);
+        bool thrown = false;
+        try {
+            scratch.Emplace(-1);
+        }
+        catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        auto b = scratch.Emplace(2);
+        scratch.Destroy(a);
+        try {
+            scratch.Emplace(-1);
+        }
+        catch (const std::runtime_error&) {
+        }
+        auto c = scratch.Emplace(3);
+
+        std::cout << "  Count: " << scratch.Count() << std::endl;
+        PrintResult(thrown && b.IsValid() && c.IsValid() && c.index == a.index
+            && scratch.Count() == 2 && scratch.Get(c)->value == 3);
+    }
+
+    // ==================================================
+    PrintCategory("チェックポイント・ロールバック");
+    // ==================================================
+
+    PrintTest("WriteCheckpoint / LoadCheckpointChain - 差分のみ追記して再生");
+    {
+        auto& pool = ObjectSlotSystem<BenchData>::GetInstance();
+        pool.Clear();
+        pool.SetCheckpointTracking(true);
+
+        std::stringstream chain(std::ios::in | std::ios::out | std::ios::binary);
+        std::vector<SlotPtr<BenchData>> objects;
+        for (int i = 0; i < 100; ++i) {
+            objects.push_back(pool.Create(BenchData{ 1.0f, 2.0f, 3.0f, i }));
+        }
+        size_t fullRecords = pool.WriteCheckpoint(chain);
+
+        objects[3]->x = 42.0f;
+        pool.MarkDirty(objects[3].GetHandle());
+        objects[7] = nullptr;
+        objects.push_back(pool.Create(BenchData{ 0.0f, 0.0f, 0.0f, 1000 }));
+        size_t deltaRecords = pool.WriteCheckpoint(chain);
+        size_t emptyRecords = pool.WriteCheckpoint(chain);
+
+        SlotHandle modified = objects[3].GetHandle();
+        SlotHandle reused = objects.back().GetHandle();
+        objects.clear();
+        pool.Clear();
+
+        auto restored = pool.LoadCheckpointChain(chain);
+        std::cout << "  全体: " << fullRecords << " 件, 差分: " << deltaRecords
+            << " 件, 復元: " << restored.size() << " 件" << std::endl;
+
+        bool restoredOk = (restored.size() == 100 && pool.Count() == 100
+            && pool.Get(modified) && pool.Get(modified)->x == 42.0f
+            && reused.index == 7 && reused.generation == modified.generation + 1
+            && pool.Get(reused) && pool.Get(reused)->id == 1000);
+
+        restored.clear();
+        pool.SetCheckpointTracking(false);
+        pool.Clear();
+
+        // 飛び地のインデックスやストリームに収まらない件数のブロックは巨大な確保をせずに拒否する
+        bool forgedRejected = true;
+        const uint32_t forgedIndices[3] = { 0xFFFFFFF0u, 1, 0 };
+        const uint64_t forgedCounts[3] = { 1, 1, 1ull << 40 };
+        for (int c = 0; c < 3; ++c) {
+            std::stringstream forged(std::ios::in | std::ios::out | std::ios::binary);
+            const uint32_t header[2] = { 0x5043534F, 1 };
+            const uint64_t sizes[2] = { sizeof(BenchData), forgedCounts[c] };
+            const uint32_t record[3] = { forgedIndices[c], 0, 0 };
+            forged.write(reinterpret_cast<const char*>(header), sizeof(header));
+            forged.write(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+            forged.write(reinterpret_cast<const char*>(record), sizeof(record));
+            forgedRejected = forgedRejected && pool.LoadCheckpointChain(forged).empty() && pool.Capacity() == 0;
+        }
+
+        PrintResult(fullRecords == 100 && deltaRecords == 2 && emptyRecords == 0 && restoredOk && forgedRejected);
+    }
+
+    PrintTest("CloneState / RestoreState - ロールバックで要素と世代番号を巻き戻す");
+    {
+        auto& pool = ObjectSlotSystem<BenchData>::GetInstance();
+        pool.Clear();
+
+        auto a = pool.Create(BenchData{ 1.0f, 0.0f, 0.0f, 1 });
+        auto b = pool.Create(BenchData{ 2.0f, 0.0f, 0.0f, 2 });
+        SlotHandle handleA = a.GetHandle();
+
+        auto state = pool.CloneState();
+
+        // 予測に基づいて進めたフレーム
+        a->x = 100.0f;
+        auto predicted = pool.Create(BenchData{ 3.0f, 0.0f, 0.0f, 3 });
+        SlotHandle predictedHandle = predicted.GetHandle();
+        predicted = nullptr;
+
+        pool.RestoreState(state);
+
+        bool valueOk = (a->x == 1.0f && b->x == 2.0f && pool.Get(handleA) == a.Get());
+        bool slotsOk = (pool.Count() == 2 && pool.Capacity() == 2 && !pool.IsValidHandle(predictedHandle));
+        auto replayed = pool.Create(BenchData{ 4.0f, 0.0f, 0.0f, 4 });
+        bool generationOk = (replayed.GetHandle() == predictedHandle);
+        std::cout << "  a.x: " << a->x << ", Count: " << pool.Count() << std::endl;
+
+        // 同じ大きさの状態を複製し直すときはバッファを再確保しない
+        replayed = nullptr;
+        pool.CloneState(state);
+        const uint32_t* generationsBuffer = state.generations.data();
+        const uint32_t* freeListBuffer = state.freeList.data();
+        pool.CloneState(state);
+        bool reuseOk = (state.freeList.size() == 1 && state.freeList.data() == freeListBuffer
+            && state.generations.data() == generationsBuffer);
+
+        a = nullptr;
+        b = nullptr;
+        pool.Clear();
+        PrintResult(valueOk && slotsOk && generationOk && reuseOk);
+    }
+
+#if defined(__cpp_impl_coroutine)
+    // ==================================================
+    PrintCategory("コルーチンによる解放待ち");
+    // ==================================================
+
+    PrintTest("co_await Released() - 解放後に遅延削除の経路から再開");
+    {
+        auto& pool = SignalSlotSystem<Device>::GetInstance();
+        pool.Clear();
+
+        std::vector<std::string> log;
+        SignalSlotPtr<Device> rebuilt;
+        auto device = pool.Create(Device{ "GPU" });
+        auto sub = device.Subscribe([&]() { log.push_back("通知"); });
+
+        RebuildOnRelease(device.GetWeak(), &log, &rebuilt);
+        bool suspended = (log.size() == 1 && !rebuilt);
+
+        device = nullptr;
+        bool resumed = (log.size() == 3 && log[1] == "通知" && log[2] == "再開"
+            && rebuilt && rebuilt->name == "GPU (再構築)");
+
+        // 既に解放済みの要素を待つ場合は中断しない
+        SignalSlotPtr<Device> immediate;
+        RebuildOnRelease(WeakSignalSlotPtr<Device>(), &log, &immediate);
+        bool readyOk = (log.size() == 5 && immediate);
+
+        for (auto& entry : log) std::cout << "  " << entry << std::endl;
+
+        rebuilt = nullptr;
+        immediate = nullptr;
+        PrintResult(suspended && resumed && readyOk && pool.Count() == 0);
+    }
+
+    PrintTest("co_await Released() - RestoreStateで消えた要素の待機側を再開");
+    {
+        auto& pool = SignalSlotSystem<BenchData>::GetInstance();
+        pool.Clear();
+
+        auto kept = pool.Create(BenchData{ 1.0f, 0.0f, 0.0f, 1 });
+        auto state = pool.CloneState();
+        auto predicted = pool.Create(BenchData{ 2.0f, 0.0f, 0.0f, 2 });
+
+        int keptResumed = 0;
+        int predictedResumed = 0;
+        CountOnRelease(kept.GetWeak(), &keptResumed);
+        CountOnRelease(predicted.GetWeak(), &predictedResumed);
+
+        // 巻き戻しで消えた要素の待機側だけが再開する
+        pool.RestoreState(state);
+        bool restoredOk = (keptResumed == 0 && predictedResumed == 1);
+
+        // 同じスロットを再利用した別の要素の解放では再開しない
+        predicted = nullptr;
+        auto reused = pool.Create(BenchData{ 3.0f, 0.0f, 0.0f, 3 });
+        reused = nullptr;
+        bool reuseOk = (predictedResumed == 1);
+
+        kept = nullptr;
+        std::cout << "  再開: 維持 " << keptResumed << " 回, 巻き戻し " << predictedResumed << " 回" << std::endl;
+        PrintResult(restoredOk && reuseOk && keptResumed == 1 && pool.Count() == 0);
+    }
+#endif
+
+    // ==================================================
+    PrintCategory("バックグラウンド破棄");
+    // ==================================================
+
+    PrintTest("UseBackgroundDestruction - デストラクタを別スレッドで実行");
+    {
+        auto& pool = ObjectSlotSystem<HeavyMesh>::GetInstance();
+        auto& destructor = BackgroundDestructor<HeavyMesh>::GetInstance();
+
+        auto mesh = pool.Create(HeavyMesh(std::vector<float>(100000, 1.0f)));
+        uint32_t index = mesh.GetHandle().index;
+        mesh = nullptr;
+
+        // スロットは破棄の完了を待たずに再利用できる
+        auto next = pool.Create(HeavyMesh(std::vector<float>(16, 2.0f)));
+        bool reused = (next.GetHandle().index == index && pool.Count() == 1);
+
+        destructor.Flush();
+        bool offThread = (HeavyMesh::destroyedCount == 1 && HeavyMesh::destroyedOn != std::this_thread::get_id());
+        std::cout << "  破棄数: " << HeavyMesh::destroyedCount
+            << ", 破棄待ち: " << destructor.PendingCount() << std::endl;
+
+        next = nullptr;
+        destructor.Flush();
+        PrintResult(reused && offThread && HeavyMesh::destroyedCount == 2);
+    }
+
+    // ==================================================
+    PrintCategory("PoolGroup");
+    // ==================================================
+
+    PrintTest("PoolGroup - 具体型ごとに連続走査して静的な型で呼び出す");
+    {
+        auto& meshSlot = RefSlotSystem<Mesh>::GetInstance();
+        auto& spriteSlot = RefSlotSystem<Sprite>::GetInstance();
+        meshSlot.Clear();
+        spriteSlot.Clear();
+
+        auto mesh1 = meshSlot.Create(Mesh{ "Box", 8 });
+        auto sprite = spriteSlot.Create(Sprite{ "Player" });
+        auto mesh2 = meshSlot.Create(Mesh{ "Sphere", 32 });
+
+        using Drawables = PoolGroup<IDrawable, Mesh, Sprite>;
+        std::vector<std::string> order;
+        int meshVertices = 0;
+        Drawables::ForEach([&](SlotHandle, auto& drawable) {
+            order.push_back(drawable.GetName());
+            if constexpr (std::is_same_v<std::decay_t<decltype(drawable)>, Mesh>) {
+                meshVertices += drawable.vertexCount;
+            }
+        });
+
+        for (auto& name : order) std::cout << "  " << name << std::endl;
+        bool orderOk = (order.size() == 3 && order[0] == "Box" && order[1] == "Sphere" && order[2] == "Player");
+        PrintResult(orderOk && meshVertices == 40 && Drawables::Count() == 3);
+    }
+
+    // ==================================================
+    PrintCategory("VariantSlotSystem");
+    // ==================================================
+
+    PrintTest("VariantSlotSystem - 複数の型を1つの配列に格納しSlotRef<Base>で参照");
+    {
+        auto& pool = VariantSlotSystem<Mesh, Sprite>::GetInstance();
+        pool.Clear();
+
+        std::vector<SlotRef<IDrawable>> drawables;
+        drawables.push_back(pool.Create(Mesh{ "Box", 8 }));
+        drawables.push_back(pool.Create(Sprite{ "Player" }));
+        auto sphere = pool.Create(Mesh{ "Sphere", 32 });
+        drawables.push_back(sphere);
+
+        // 挿入順の局所性: 型が違っても隣り合うスロットに並ぶ
+        std::vector<std::string> slotOrder;
+        pool.ForEach([&](SlotHandle, auto& d) { slotOrder.push_back(d.GetName()); });
+
+        // タグごとにまとめて走査
+        std::vector<std::string> visitOrder;
+        pool.Visit([&](SlotHandle, auto& d) { visitOrder.push_back(d.GetName()); });
+
+        SlotHandle sphereHandle = pool.GetHandle(sphere.Get());
+        bool typedOk = (pool.Get<Mesh>(sphereHandle) == sphere.Get() && pool.Get<Sprite>(sphereHandle) == nullptr
+            && pool.GetRefCount(sphereHandle) == 2);
+
+        for (auto& name : visitOrder) std::cout << "  " << name << std::endl;
+
+        sphere = nullptr;
+        drawables.pop_back();
+        bool releasedOk = (pool.Count() == 2 && !pool.IsValidHandle(sphereHandle));
+
+        drawables.clear();
+        bool slotOk = (slotOrder.size() == 3 && slotOrder[0] == "Box" && slotOrder[1] == "Player" && slotOrder[2] == "Sphere");
+        bool visitOk = (visitOrder.size() == 3 && visitOrder[0] == "Box" && visitOrder[1] == "Sphere" && visitOrder[2] == "Player");
+        PrintResult(slotOk && visitOk && typedOk && releasedOk && pool.Count() == 0);
+    }
+
+    // ==================================================
+    PrintCategory("グラフのシリアライズ");
+    // ==================================================
+
+    PrintTest("SlotGraphWriter/Reader - プールをまたぐ参照をインデックスに置き換えて保存・復元");
+    {
+        auto& materials = ObjectSlotSystem<GraphMaterial>::GetInstance();
+        auto& nodes = ObjectSlotSystem<GraphNode>::GetInstance();
+        auto& meshes = RefSlotSystem<Mesh>::GetInstance();
+
+        std::stringstream stream;
+        bool writeOk = false;
+        {
+            auto metal = materials.Create(GraphMaterial{ "Metal", 0.25f });
+            auto unused = materials.Create(GraphMaterial{ "Unused", 1.0f });
+            auto wood = materials.Create(GraphMaterial{ "Wood", 0.75f });
+            unused = nullptr; // 削除済みスロットを含める
+            auto box = meshes.Create(Mesh{ "Box", 8 });
+
+            auto root = nodes.Create(GraphNode{ "Root", { 1, 2 }, metal, nullptr, SlotRef<IDrawable>(box) });
+            auto child = nodes.Create(GraphNode{ "Child", { 3 }, wood, root, nullptr });
+
+            SlotGraphWriter writer(stream);
+            writer.RegisterPool(materials);
+            writer.RegisterPool(nodes);
+            writer.RegisterPool(meshes);
+            writeOk = writer.Write();
+        }
+        const std::string written = stream.str();
+        bool releasedOk = (materials.Count() == 0 && nodes.Count() == 0 && meshes.Count() == 0);
+
+        // 取り出さなかった所有者はReaderの破棄時に手放され、ノードから参照される要素だけが残る
+        bool readOk = false;
+        std::vector<SlotPtr<GraphNode>> loaded;
+        {
+            SlotGraphReader reader(stream);
+            reader.RegisterPool(materials);
+            reader.RegisterPool(nodes);
+            reader.RegisterPool(meshes);
+            readOk = reader.Read();
+            loaded = reader.TakeObjects(nodes);
+        }
+        bool graphOk = false;
+        if (loaded.size() == 2) {
+            const GraphNode& root = *loaded[0];
+            const GraphNode& child = *loaded[1];
+            std::cout << "  " << child.name << " -> 親: " << child.parent->name
+                << ", マテリアル: " << child.material->name << std::endl;
+            std::cout << "  " << root.name << " -> 描画: " << root.drawable->GetName() << std::endl;
+            graphOk = (root.name == "Root" && root.tags.size() == 2 && root.tags[1] == 2
+                && root.material->name == "Metal" && root.parent == nullptr
+                && root.drawable->GetName() == "Box"
+                && child.parent.Get() == loaded[0].Get() && child.material->roughness == 0.75f
+                && child.drawable == nullptr);
+        }
+        // 削除済みスロットのインデックスもそのまま保たれる
+        bool indexOk = (materials.Count() == 2 && materials.Capacity() == 3 && meshes.Count() == 1);
+
+        loaded.clear();
+        bool cleanupOk = (materials.Count() == 0 && nodes.Count() == 0 && meshes.Count() == 0);
+
+        // 壊れた長さや途中で途切れたデータは、巨大な確保をせずに拒否してプールを空に戻す
+        // （先頭12バイト＋各プールのヘッダ12バイトと生存フラグの後に、最初の要素の名前の長さがある）
+        std::string corrupt = written;
+        const uint64_t hugeLength = 1ull << 46;
+        std::memcpy(&corrupt[12 + (12 + 3) + (12 + 2) + (12 + 1)], &hugeLength, sizeof(hugeLength));
+        const std::string truncated = written.substr(0, written.size() - 4);
+        bool rejectedOk = true;
+        for (const std::string& bytes : { corrupt, truncated }) {
+            std::stringstream in(bytes);
+            SlotGraphReader reader(in);
+            reader.RegisterPool(materials);
+            reader.RegisterPool(nodes);
+            reader.RegisterPool(meshes);
+            rejectedOk = rejectedOk && !reader.Read()
+                && materials.Count() == 0 && nodes.Count() == 0 && meshes.Count() == 0;
+        }
+        PrintResult(writeOk && releasedOk && readOk && graphOk && indexOk && cleanupOk && rejectedOk);
+    }
+
+    // ==================================================
+    PrintCategory("Clearの世代エポック");
+    // ==================================================
+
+    PrintTest("Clear - 古いハンドルが再利用スロットの新しい要素と一致しない");
+    {
+        auto& pool = ObjectSlotSystem<BenchData>::GetInstance();
+        pool.Clear();
+
+        SlotHandle oldHandle;
+        WeakSlotPtr<BenchData> oldWeak;
+        {
+            auto first = pool.Create(BenchData{ 1.0f, 2.0f, 3.0f, 1 });
+            oldHandle = first.GetHandle();
+            oldWeak = first.GetWeak();
+
+            // トリビアルに破棄可能な型なのでスロットを走査せずに全要素を破棄する
+            pool.Clear();
+        }
+
+        auto reused = pool.Create(BenchData{ 4.0f, 5.0f, 6.0f, 2 });
+        SlotHandle newHandle = reused.GetHandle();
+        std::cout << "  旧ハンドル: (" << oldHandle.index << ", " << oldHandle.generation << ")"
+            << " 新ハンドル: (" << newHandle.index << ", " << newHandle.generation << ")" << std::endl;
+
+        bool sameIndex = (oldHandle.index == newHandle.index);
+        bool staleOk = (!pool.IsValidHandle(oldHandle) && !oldWeak.Lock() && pool.Get(oldHandle) == nullptr);
+        bool newOk = (pool.IsValidHandle(newHandle) && pool.Get(newHandle)->id == 2);
+
+        reused = nullptr;
+        PrintResult(sameIndex && staleOk && newOk && pool.Count() == 0);
+    }
+
+    // ==================================================
+    PrintCategory("TransientSlotSystem");
+    // ==================================================
+
+    PrintTest("TransientSlotSystem - フレーム単位で一括破棄し、前フレームのハンドルを無効化");
+    {
+        auto& frame = TransientSlotSystem<BenchData>::GetInstance();
+        frame.ResetFrame();
+
+        SlotHandle first = frame.Create(BenchData{ 1.0f, 0.0f, 0.0f, 1 });
+        for (int i = 2; i <= 100; ++i) {
+            frame.Emplace(BenchData{ static_cast<float>(i), 0.0f, 0.0f, i });
+        }
+
+        float sum = 0.0f;
+        frame.ForEach([&](SlotHandle, BenchData& d) { sum += d.x; });
+        bool firstFrameOk = (frame.Count() == 100 && sum == 5050.0f && frame.Get(first)->id == 1);
+
+        frame.ResetFrame();
+        SlotHandle next = frame.Create(BenchData{ 0.0f, 0.0f, 0.0f, 200 });
+        std::cout << "  前フレーム: (" << first.index << ", " << first.generation << ")"
+            << " 次フレーム: (" << next.index << ", " << next.generation << ")" << std::endl;
+
+        // 同じインデックスでもフレームが違えば無効
+        bool nextFrameOk = (next.index == first.index && frame.Get(first) == nullptr
+            && frame.Get(next)->id == 200 && frame.Count() == 1);
+
+        frame.ResetFrame();
+        PrintResult(firstFrameOk && nextFrameOk && frame.Count() == 0);
+    }
+
+    // ==================================================
+    PrintCategory("UniqueSlotPtr");
+    // ==================================================
+
+    PrintTest("UniqueSlotPtr - 参照カウントを使わずに所有権を移動し、SlotPtrへ変換");
+    {
+        auto& pool = ObjectSlotSystem<Mesh>::GetInstance();
+        size_t before = pool.Count();
+
+        std::cout << "  sizeof(UniqueSlotPtr<Mesh>) = " << sizeof(UniqueSlotPtr<Mesh>)
+            << " / sizeof(SlotPtr<Mesh>) = " << sizeof(SlotPtr<Mesh>) << std::endl;
+
+        UniqueSlotPtr<Mesh> owner = pool.CreateUnique(Mesh{ "Unique", 12 });
+        SlotHandle handle = owner.GetHandle();
+        WeakSlotPtr<Mesh> weak = owner.GetWeak();
+
+        std::vector<UniqueSlotPtr<Mesh>> owners;
+        owners.push_back(std::move(owner));
+        owners.push_back(pool.CreateUnique(Mesh{ "Temp", 3 }));
+        bool moveOk = (owner == nullptr && owners[0]->vertexCount == 12
+            && pool.GetRefCount(handle) == 1 && weak.IsValid());
+
+        // 破棄すると即座に削除される
+        SlotHandle tempHandle = owners[1].GetHandle();
+        owners.pop_back();
+        bool destroyOk = (!pool.IsValidHandle(tempHandle) && pool.Count() == before + 1);
+
+        // 弱参照からLock()した参照が残っていれば、最後の参照が外れたときに削除される
+        UniqueSlotPtr<Mesh> locked = pool.CreateUnique(Mesh{ "Locked", 5 });
+        SlotPtr<Mesh> borrowed = locked.GetWeak().Lock();
+        locked = nullptr;
+        bool lockOk = (borrowed && borrowed->vertexCount == 5 && borrowed.UseCount() == 1);
+        borrowed = nullptr;
+        lockOk = lockOk && pool.Count() == before + 1;
+
+        // 共有が必要になったらSlotPtrに変換
+        SlotPtr<Mesh> shared = std::move(owners[0]);
+        SlotPtr<Mesh> copy = shared;
+        bool sharedOk = (owners[0] == nullptr && shared.GetHandle() == handle && shared.UseCount() == 2);
+
+        shared = nullptr;
+        copy = nullptr;
+        bool releasedOk = (!weak.IsValid() && pool.Count() == before);
+        PrintResult(moveOk && destroyOk && lockOk && sharedOk && releasedOk);
+    }
+
+    // ==================================================
+    PrintCategory("占有状況のエクスポート");
+    // ==================================================
+
+    PrintTest("ExportOccupancyMap - ページごとの生存・削除済みスロットをCSVで出力");
+    {
+        auto& pool = ObjectSlotSystem<BenchData>::GetInstance();
+        pool.Clear();
+        pool.SetPoolName("BenchData");
+        pool.SetAgeTracking(true);
+
+        std::vector<SlotPtr<BenchData>> objects;
+        for (int i = 0; i < 2000; ++i) {
+            objects.push_back(pool.Create(BenchData{ 0.0f, 0.0f, 0.0f, i }));
+        }
+        // 前半を1つおきに解放して断片化させる
+        for (int i = 0; i < 1000; i += 2) {
+            objects[i] = nullptr;
+        }
+
+        std::stringstream csv;
+        size_t rows = ExportOccupancyMap(csv);
+
+        // 自分のプールの行だけを集計する
+        std::string line;
+        std::getline(csv, line);
+        bool headerOk = (line == "timestamp_ms,pool,page,first_slot,slots,live,dead,committed,oldest_age_ms");
+        size_t pages = 0, live = 0, dead = 0, aged = 0, fragmented = 0;
+        while (std::getline(csv, line)) {
+            if (line.find(",\"BenchData\",") == std::string::npos) continue;
+            std::vector<std::string> cols;
+            std::stringstream fields(line);
+            std::string col;
+            while (std::getline(fields, col, ',')) cols.push_back(col);
+            if (cols.size() < 8) continue;
+            size_t pageLive = std::stoul(cols[5]);
+            size_t pageDead = std::stoul(cols[6]);
+            ++pages;
+            live += pageLive;
+            dead += pageDead;
+            if (cols.size() == 9 && !cols[8].empty()) ++aged;
+            if (pageLive > 0 && pageDead > 0) ++fragmented;
+        }
+        std::cout << "  BenchData: " << pages << " ページ, 生存 " << live << ", 削除済み " << dead
+            << ", 断片化ページ " << fragmented << " (全 " << rows << " 行)" << std::endl;
+
+        objects.clear();
+        pool.SetAgeTracking(false);
+        pool.SetPoolName("");
+        pool.Clear();
+        PrintResult(headerOk && pages > 0 && live == 1500 && dead == 500 && aged > 0 && fragmented > 0);
+    }
+
+    // ==================================================
+    PrintCategory("処理時間のヒストグラム");
+    // ==================================================
+
+    PrintTest("LatencyHistogram - 対数バケットでパーセンタイルを求める");
+    {
+        LatencyHistogram histogram;
+        for (uint64_t v = 1; v <= 1000; ++v) {
+            histogram.Record(v);
+        }
+        histogram.Record(1000000);
+
+        uint64_t p50 = histogram.Percentile(50.0);
+        uint64_t p999 = histogram.Percentile(99.9);
+        std::cout << "  p50 = " << p50 << ", p99.9 = " << p999 << ", max = " << histogram.Max() << std::endl;
+
+        // バケットの相対誤差は約6%以内
+        bool p50Ok = (p50 >= 500 && p50 <= 500 * 107 / 100);
+        bool tailOk = (p999 >= 1000 && p999 <= 1000 * 107 / 100 && histogram.Percentile(100.0) == 1000000);
+        PrintResult(p50Ok && tailOk && histogram.Count() == 1001 && histogram.Min() == 1);
+    }
+
+    PrintTest("SetLatencyTracking - 作成・削除・通知と遅延削除の件数を記録");
+    {
+        auto& pool = SignalSlotSystem<Device>::GetInstance();
+        pool.SetLatencyTracking(true);
+
+        auto root = pool.Create(Device{ "Root" });
+        std::vector<SignalSlotPtr<Device>> children;
+        for (int i = 0; i < 10; ++i) {
+            children.push_back(pool.Create(Device{ "Child" }));
+        }
+
+        // 通知の中で子を解放すると、通知完了後にまとめて遅延削除される
+        auto sub = root.Subscribe([&children]() { children.clear(); });
+        root = nullptr;
+
+        const SlotLatencyStats* stats = pool.GetLatencyStats();
+        std::stringstream dump;
+        pool.DumpLatencyStats(dump);
+        std::cout << dump.str();
+
+        bool statsOk = (stats != nullptr && stats->create.Count() == 11 && stats->release.Count() == 11
+            && stats->notify.Count() == 1 && stats->removalBatch.Count() == 1 && stats->removalBatch.Max() == 10);
+
+        pool.SetLatencyTracking(false);
+        PrintResult(statsOk && pool.GetLatencyStats() == nullptr && children.empty());
+    }
+
+    // ==================================================
+    PrintCategory("解放の連鎖のトレース");
+    // ==================================================
+
+    PrintTest("SlotTraceRecorder - 通知から連鎖した削除をChromeトレース形式で出力");
+    {
+        auto& pool = SignalSlotSystem<Device>::GetInstance();
+        pool.SetPoolName("Device");
+
+        auto root = pool.Create(Device{ "Root" });
+        std::vector<SignalSlotPtr<Device>> children;
+        for (int i = 0; i < 3; ++i) {
+            children.push_back(pool.Create(Device{ "Child" }));
+        }
+        auto sub = root.Subscribe([&children]() { children.clear(); });
+
+        SlotTraceRecorder& recorder = SlotTraceRecorder::GetInstance();
+        recorder.Enable(256);
+        root = nullptr;
+        recorder.Disable();
+
+        size_t begins = 0;
+        size_t ends = 0;
+        size_t executeRemovals = 0;
+        size_t batches = 0;
+        recorder.ForEachEvent([&](const SlotTraceEvent& event) {
+            if (event.phase == 'B') ++begins;
+            if (event.phase == 'E') ++ends;
+            if (event.phase == 'B' && std::string(event.name) == "ExecuteRemoval") ++executeRemovals;
+            if (event.phase == 'B' && std::string(event.name) == "ProcessPendingRemovals" && event.count == 3) ++batches;
+        });
+
+        std::stringstream json;
+        size_t written = recorder.WriteChromeTrace(json);
+        std::cout << "  イベント数: " << written << " (B=" << begins << ", E=" << ends << ")" << std::endl;
+
+        bool jsonOk = (json.str().find("\"traceEvents\"") != std::string::npos
+            && json.str().find("\"pool\":\"Device\"") != std::string::npos);
+
+        recorder.Clear();
+        pool.SetPoolName("");
+        PrintResult(begins == ends && executeRemovals == 4 && batches == 1 && written == begins + ends && jsonOk);
+    }
+
+    // ==================================================
+    PrintCategory("連鎖解放の反復処理");
+    // ==================================================
+
+    PrintTest("ObjectSlotSystem - 深い所有チェーンを再帰せずに解放");
+    {
+        auto& pool = ObjectSlotSystem<ChainNode>::GetInstance();
+        pool.SetLatencyTracking(true);
+
+        // 先頭から末尾まで SlotPtr で所有し合う長い連結リスト
+        // 再帰的に解放するとスタックが溢れる長さにする
+        const int length = 200000;
+        SlotPtr<ChainNode> head;
+        for (int i = 0; i < length; ++i) {
+            head = pool.Create(ChainNode{ i, std::move(head) });
+        }
+        size_t built = pool.Count();
+
+        head = nullptr;
+
+        const SlotLatencyStats* stats = pool.GetLatencyStats();
+        std::cout << "  作成: " << built << ", 解放後: " << pool.Count()
+            << ", 遅延削除の回数: " << stats->removalBatch.Count()
+            << ", 件数: " << stats->removalBatch.Max() << std::endl;
+
+        // 先頭の削除の中で連鎖した解放は、全て1回の一括処理にまとまる
+        bool batchOk = (stats->removalBatch.Count() == 1 && stats->removalBatch.Max() == length - 1);
+
+        pool.SetLatencyTracking(false);
+        PrintResult(built == static_cast<size_t>(length) && pool.Count() == 0 && batchOk);
+    }
+
+    // ==================================================
+    PrintCategory("循環参照の回収");
+    // ==================================================
+
+    PrintTest("SlotCycleCollector - 外から到達できない循環だけを解放");
+    {
+        auto& pool = ObjectSlotSystem<CycleNode>::GetInstance();
+        auto& materials = ObjectSlotSystem<GraphMaterial>::GetInstance();
+        pool.SetCycleCollection(true);
+        SlotCycleCollector& collector = SlotCycleCollector::GetInstance();
+        const size_t materialsBefore = materials.Count();
+
+        // 外から参照されなくなる循環（a → b → a）。aは他のプールの要素も所有する
+        {
+            auto a = pool.Create(CycleNode{ "A" });
+            auto b = pool.Create(CycleNode{ "B" });
+            a->next = b;
+            b->next = a;
+            a->material = materials.Create(GraphMaterial{ "Leaked", 0.5f });
+        }
+
+        // 外から参照され続ける循環（keep → child → keep）
+        auto keep = pool.Create(CycleNode{ "Keep" });
+        keep->children.push_back(pool.Create(CycleNode{ "Child" }));
+        keep->children[0]->next = keep;
+
+        // 多数の循環を時間制限付きで少しずつ回収する（解放数には他のプールの要素も含む）
+        for (int i = 0; i < 1000; ++i) {
+            auto x = pool.Create(CycleNode{ "X" });
+            auto y = pool.Create(CycleNode{ "Y" });
+            x->next = y;
+            y->next = x;
+        }
+
+        size_t leaked = pool.Count();
+        size_t firstPass = collector.Collect(std::chrono::nanoseconds(0));
+        size_t pendingAfterFirst = collector.PendingRoots();
+        size_t rest = collector.CollectAll();
+
+        std::cout << "  回収前: " << leaked << ", 1回目: " << firstPass << " (残り候補 " << pendingAfterFirst
+            << "), 残り: " << rest << ", 回収後: " << pool.Count() << std::endl;
+
+        bool incrementalOk = (firstPass > 0 && pendingAfterFirst > 0 && firstPass + rest == 2003);
+        bool liveOk = (pool.Count() == 2 && keep->children[0]->next == keep);
+        bool materialOk = (materials.Count() == materialsBefore);
+
+        // 生存している循環は手動で切ってから解放する
+        keep->children.clear();
+        keep = nullptr;
+        bool releasedOk = (pool.Count() == 0);
+
+        // 候補のまま削除されたスロットを再利用した要素も、循環の候補になる
+        pool.Clear();
+        bool reuseOk = false;
+        {
+            auto first = pool.Create(CycleNode{ "First" });
+            { auto copy = first; }
+            const uint32_t index = first.GetHandle().index;
+            first = nullptr;
+
+            auto reused = pool.Create(CycleNode{ "Reused" });
+            reused->next = reused;
+            reuseOk = (reused.GetHandle().index == index);
+        }
+        reuseOk = reuseOk && pool.Count() == 1 && collector.CollectAll() == 1 && pool.Count() == 0;
+
+        pool.SetCycleCollection(false);
+        PrintResult(incrementalOk && liveOk && materialOk && releasedOk && reuseOk);
+    }
+
+    // ==================================================
+    PrintCategory("ストリーミング走査");
+    // ==================================================
+
+    PrintTest("StreamingForEach - 区間ごとに先読み・解放を助言しながら全要素を走査");
+    {
+        auto& pool = ObjectSlotSystem<BenchData>::GetInstance();
+        pool.Clear();
+
+        std::vector<SlotPtr<BenchData>> objects;
+        for (int i = 0; i < 20000; ++i) {
+            objects.push_back(pool.Create(BenchData{ 1.0f, 0.0f, 0.0f, i }));
+        }
+        for (int i = 0; i < 20000; i += 3) {
+            objects[i] = nullptr;
+        }
+
+        long long expected = 0;
+        pool.ForEach([&expected](SlotHandle, BenchData& data) { expected += data.id; });
+
+        // 2ページずつの区間で走査し、走査中に要素を書き換える
+        long long streamed = 0;
+        size_t visited = 0;
+        uint32_t lastIndex = 0;
+        bool ordered = true;
+        pool.StreamingForEach([&](SlotHandle handle, BenchData& data) {
+            if (visited > 0 && handle.index <= lastIndex) ordered = false;
+            lastIndex = handle.index;
+            streamed += data.id;
+            data.x = 2.0f;
+            ++visited;
+        }, virtual_memory_allocator::get_page_size() * 2);
+
+        bool writtenOk = true;
+        pool.ForEach([&writtenOk](SlotHandle, BenchData& data) { if (data.x != 2.0f) writtenOk = false; });
+
+        std::cout << "  走査: " << visited << " 要素, 合計 " << streamed << " (期待値 " << expected << ")" << std::endl;
+        PrintResult(visited == pool.Count() && streamed == expected && ordered && writtenOk);
+    }
+
+    // ==================================================
+    PrintCategory("高速終了");
+    // ==================================================
+
+    PrintTest("SlotFastExit - プール破棄時の要素の破棄を省略し、指定したプールだけ破棄");
+    {
+        SlotFastExit::SetEnabled(true);
+
+        // 高速終了では生存要素のデストラクタを呼ばない
+        {
+            ExitProbePool pool;
+            for (int i = 0; i < 3; ++i) pool.Add(i);
+            ExitProbe::destroyed = 0;
+        }
+        int skipped = ExitProbe::destroyed;
+
+        // SetFlushOnExit(true)のプールは通常通り破棄する
+        {
+            ExitProbePool pool;
+            pool.SetFlushOnExit(true);
+            for (int i = 0; i < 3; ++i) pool.Add(i);
+            ExitProbe::destroyed = 0;
+        }
+        int flushed = ExitProbe::destroyed;
+
+        SlotFastExit::SetEnabled(false);
+        std::cout << "  高速終了で破棄: " << skipped << ", フラッシュ指定で破棄: " << flushed << std::endl;
+        PrintResult(skipped == 0 && flushed == 3);
+    }
+
+    // ==================================================
+    PrintCategory("予約プロファイル");
+    // ==================================================
+
+    PrintTest("SlotReservationProfile - 前回のピークで事前確保し、今回のピークを書き出す");
+    {
+        const std::string loadPath = (std::filesystem::temp_directory_path() / "objectslot_reservation_profile_in.txt").string();
+        const std::string savePath = (std::filesystem::temp_directory_path() / "objectslot_reservation_profile_out.txt").string();
+        const std::string key = typeid(ProfiledItem).name();
+
+        // 前回の実行で書き出されたプロファイル
+        {
+            std::ofstream file(loadPath);
+            file << "# ObjectSlot reservation profile v1\n";
+            file << "5000,0," << key << "\n";
+            // 壊れた行は読み飛ばす
+            file << "99999999999999999999,0,CorruptCount\n";
+            file << "12x,0,CorruptDigits\n";
+            file << "-1,0,NegativeCount\n";
+        }
+
+        SlotReservationProfile& profile = SlotReservationProfile::GetInstance();
+        size_t loaded = profile.Load(loadPath, true);
+
+        // 読み込み後に作成されたプールは作成時に前回のピーク分をコミット済みになる
+        auto& pool = ObjectSlotSystem<ProfiledItem>::GetInstance();
+        bool reservedOk = (pool.PeakCommittedBytes() >= 5000 * sizeof(ProfiledItem));
+
+        // 予約済みの仮想アドレス空間を超える要求は切り詰めて失敗として返す
+        bool clampReported = !pool.ApplyReservation(size_t(1) << 40, false)
+            && profile.FailedReservationCount() == 0;
+
+        std::vector<SlotPtr<ProfiledItem>> items;
+        for (int i = 0; i < 300; ++i) {
+            items.push_back(pool.Create(ProfiledItem{}));
+        }
+        items.resize(200);
+
+        profile.Save(savePath);
+        std::ifstream saved(savePath);
+        std::string line;
+        std::string written;
+        while (std::getline(saved, line)) {
+            if (line.size() > key.size() && line.compare(line.size() - key.size(), key.size(), key) == 0) {
+                written = line;
+            }
+        }
+        saved.close();
+
+        std::cout << "  読み込み: " << loaded << " プール, 書き出し: " << written << std::endl;
+
+        std::remove(loadPath.c_str());
+        std::remove(savePath.c_str());
+        PrintResult(loaded == 1 && reservedOk && clampReported && pool.PeakCount() == 300 && written.rfind("300,", 0) == 0);
+    }
+
+    // ==================================================
+    PrintCategory("メモリ予算");
+    // ==================================================
+
+    PrintTest("SetMemoryBudget - ソフト閾値で1回通知し、ハード閾値ではコールバックで縮小できなければ作成を拒否");
+    {
+        auto& pool = ObjectSlotSystem<PayloadItem>::GetInstance();
+        std::vector<SlotPtr<PayloadItem>> items;
+        for (int i = 0; i < 10000; ++i) {
+            items.push_back(pool.Create(PayloadItem{}));
+        }
+        const size_t used = pool.MemoryUsageBytes();
+
+        // ソフト閾値: 超えている間も通知は1回だけ
+        int softCalls = 0;
+        pool.SetMemoryBudget(used / 2, 0, [&](const SlotBudgetEvent& event) {
+            if (event.level == SlotBudgetLevel::Soft) ++softCalls;
+        });
+        items.push_back(pool.Create(PayloadItem{}));
+        items.push_back(pool.Create(PayloadItem{}));
+        bool softOk = (softCalls == 1 && items.back());
+
+        // ハード閾値: コールバックで何もしなければ作成を拒否する
+        int hardCalls = 0;
+        pool.SetMemoryBudget(0, used / 2, [&](const SlotBudgetEvent& event) {
+            if (event.level == SlotBudgetLevel::Hard && event.pool == &pool) ++hardCalls;
+        });
+        bool rejected = !pool.Create(PayloadItem{});
+
+        // CanCreate()は最大容量だけを見る問い合わせで、予算のコールバックを呼ばない
+        const SlotControlBase& constPool = pool;
+        bool queryOk = (constPool.CanCreate() && hardCalls == 1);
+
+        // ハード閾値: コールバックで要素を解放して縮小すれば作成を続行する
+        pool.SetMemoryBudget(0, used / 2, [&](const SlotBudgetEvent&) {
+            ++hardCalls;
+            items.clear();
+            pool.ShrinkToFit();
+        });
+        SlotPtr<PayloadItem> created = pool.Create(PayloadItem{});
+        const size_t after = pool.MemoryUsageBytes();
+        pool.ClearMemoryBudget();
+
+        std::cout << "  使用量: " << used << " -> " << after << " バイト, ハード閾値の通知: " << hardCalls << std::endl;
+        PrintResult(softOk && rejected && queryOk && hardCalls == 2 && created && after < used / 2);
+    }
+
+    PrintTest("SlotGlobalMemoryBudget - 全プールの合計でハード閾値を超えると作成を拒否");
+    {
+        const size_t total = SlotControlBase::TotalMemoryUsageBytes();
+        bool globalEvent = false;
+        SlotGlobalMemoryBudget::GetInstance().SetBudget(0, total, [&](const SlotBudgetEvent& event) {
+            globalEvent = event.global && event.level == SlotBudgetLevel::Hard;
+        });
+
+        auto& pool = ObjectSlotSystem<PayloadItem>::GetInstance();
+        std::vector<SlotPtr<PayloadItem>> items;
+        while (items.size() < 100000) {
+            SlotPtr<PayloadItem> item = pool.Create(PayloadItem{});
+            if (!item) break;
+            items.push_back(std::move(item));
+        }
+        SlotGlobalMemoryBudget::GetInstance().ClearBudget();
+
+        std::cout << "  合計: " << total << " バイト, 拒否までに作成: " << items.size() << std::endl;
+        PrintResult(globalEvent && items.size() < 100000 && pool.Create(PayloadItem{}));
+    }
+
+    // ==================================================
+    PrintCategory("メモリ逼迫への応答");
+    // ==================================================
+
+    PrintTest("MemoryPressureWatcher - memory.eventsの増加で内側の空きページを返却し、PSIは停止時間の増加で応答");
+    {
+        auto& pool = ObjectSlotSystem<PayloadItem>::GetInstance();
+        pool.Clear();
+        std::vector<SlotPtr<PayloadItem>> items;
+        for (uint64_t i = 0; i < 20000; ++i) {
+            items.push_back(pool.Create(PayloadItem{ { i } }));
+        }
+        // 先頭と末尾だけ残し、ShrinkToFitでは返却できない内側の空きを作る
+        SlotPtr<PayloadItem> first = items.front();
+        SlotPtr<PayloadItem> last = items.back();
+        items.clear();
+
+        const std::string path = (std::filesystem::temp_directory_path() / "objectslot_memory_events.txt").string();
+        { std::ofstream file(path); file << "low 0\nhigh 0\nmax 0\noom 0\noom_kill 0\n"; }
+
+        MemoryPressureWatcher watcher(path);
+        int actions = 0;
+        watcher.AddAction([&](const MemoryPressureEvent& event) {
+            if (event.highDelta == 3) ++actions;
+        });
+        bool baseline = !watcher.Poll();
+
+        { std::ofstream file(path); file << "low 0\nhigh 3\nmax 0\noom 0\noom_kill 0\n"; }
+        bool responded = watcher.Poll();
+        bool steady = !watcher.Poll();
+
+        // 返却したスロットも再利用でき、残した要素の内容は変わらない
+        std::vector<SlotPtr<PayloadItem>> reused;
+        for (uint64_t i = 0; i < 1000; ++i) {
+            reused.push_back(pool.Create(PayloadItem{ { i + 7 } }));
+        }
+        bool reuseOk = reused[999]->payload[0] == 1006 && first->payload[0] == 0 && last->payload[0] == 19999;
+
+        // PSI形式: avg10がしきい値以上で停止時間が増えている間だけ応答する
+        { std::ofstream file(path); file << "some avg10=25.00 avg60=5.00 avg300=1.00 total=1000\nfull avg10=0.00 avg60=0.00 avg300=0.00 total=0\n"; }
+        watcher.SetSource(path);
+        bool psiFirst = watcher.Poll();
+        bool psiStalled = !watcher.Poll();
+
+        std::remove(path.c_str());
+        std::cout << "  返却: " << watcher.LastReleasedBytes() << " バイト, 応答回数: " << watcher.ResponseCount() << std::endl;
+        PrintResult(baseline && responded && steady && actions == 1 && reuseOk
+            && psiFirst && psiStalled && watcher.ResponseCount() == 2 && watcher.LastReleasedBytes() > 0);
+    }
+
+    // ==================================================
+    PrintCategory("作成位置のサンプリング");
+    // ==================================================
+
+    PrintTest("SetAllocationSampling - 作成位置ごとの推定生存数を集計し、解放された位置と区別する");
+    {
+        auto& pool = ObjectSlotSystem<PayloadItem>::GetInstance();
+        pool.Clear();
+        pool.SetAllocationSampling(10);
+
+        std::vector<SlotPtr<PayloadItem>> kept;
+        const uint32_t keptLine = __LINE__; for (int i = 0; i < 1000; ++i) kept.push_back(pool.Create(PayloadItem{}));
+        const uint32_t releasedLine = __LINE__; for (int i = 0; i < 500; ++i) { auto temp = pool.Create(PayloadItem{}); }
+
+        const SlotAllocationSiteStats* keptSite = nullptr;
+        const SlotAllocationSiteStats* releasedSite = nullptr;
+        for (const SlotAllocationSiteStats& stats : pool.GetAllocationSampler()->Sites()) {
+            if (stats.site.line == keptLine) keptSite = &stats;
+            if (stats.site.line == releasedLine) releasedSite = &stats;
+        }
+
+        std::ostringstream report;
+        pool.DumpAllocationSites(report);
+        const std::string text = report.str();
+        const std::string firstSite = text.substr(text.find('\n') + 1, text.find('\n', text.find('\n') + 1) - text.find('\n') - 1);
+        std::cout << firstSite << std::endl;
+
+        bool ok = keptSite && releasedSite
+            && keptSite->sampledCreates == 100 && keptSite->sampledLive == 100
+            && releasedSite->sampledCreates == 50 && releasedSite->sampledLive == 0
+            && firstSite.find("live~1000 (" + std::to_string(1000 * sizeof(PayloadItem)) + " bytes)") != std::string::npos
+            && firstSite.find(":" + std::to_string(keptLine)) != std::string::npos;
+        pool.SetAllocationSampling(0);
+        PrintResult(ok && pool.GetAllocationSampler() == nullptr);
+    }
+
     // ==================================================
     PrintCategory("shared_ptr との速度比較");
     // ==================================================
@@ -1036,6 +2341,67 @@ int main()
         PrintBenchmark("ポリモーフィックアクセス（SlotRef vs shared_ptr<Base>）", slotNs, sharedNs);
     }
 
+    // --- ポリモーフィック一括走査（SlotRef vs PoolGroup）---
+    std::cout << std::endl;
+    {
+        auto& poolA = RefSlotSystem<BenchObjectA>::GetInstance();
+        auto& poolB = RefSlotSystem<BenchObjectB>::GetInstance();
+        poolA.Clear();
+        poolB.Clear();
+
+        // 2種類の具体型を交互に並べる
+        std::vector<SlotRef<IBenchObject>> slotRefs;
+        std::vector<SignalSlotPtr<BenchObjectA>> ownersA;
+        std::vector<SignalSlotPtr<BenchObjectB>> ownersB;
+        slotRefs.reserve(BENCH_POLY_COUNT);
+        for (int i = 0; i < BENCH_POLY_COUNT; ++i) {
+            if (i % 2 == 0) {
+                ownersA.push_back(poolA.Create(BenchObjectA{ static_cast<float>(i) }));
+                slotRefs.push_back(SlotRef<IBenchObject>(ownersA.back()));
+            }
+            else {
+                ownersB.push_back(poolB.Create(BenchObjectB{ static_cast<float>(i) }));
+                slotRefs.push_back(SlotRef<IBenchObject>(ownersB.back()));
+            }
+        }
+
+        constexpr int PASS_COUNT = 20;
+
+        double refSum = 0.0;
+        auto refStart = std::chrono::high_resolution_clock::now();
+        for (int pass = 0; pass < PASS_COUNT; ++pass) {
+            for (auto& ref : slotRefs) {
+                refSum += ref->GetValue();
+            }
+        }
+        auto refEnd = std::chrono::high_resolution_clock::now();
+        double refNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            refEnd - refStart).count()) / (static_cast<double>(BENCH_POLY_COUNT) * PASS_COUNT);
+
+        double groupSum = 0.0;
+        auto groupStart = std::chrono::high_resolution_clock::now();
+        for (int pass = 0; pass < PASS_COUNT; ++pass) {
+            PoolGroup<IBenchObject, BenchObjectA, BenchObjectB>::ForEach([&](SlotHandle, auto& obj) {
+                groupSum += obj.GetValue();
+            });
+        }
+        auto groupEnd = std::chrono::high_resolution_clock::now();
+        double groupNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            groupEnd - groupStart).count()) / (static_cast<double>(BENCH_POLY_COUNT) * PASS_COUNT);
+
+        double ratio = (refNs > 0.0) ? groupNs / refNs : 0.0;
+        std::cout << std::fixed;
+        std::cout.precision(2);
+        std::cout << "  ポリモーフィック一括走査（PoolGroup vs SlotRef<Base>）:" << std::endl;
+        std::cout << "    PoolGroup  : " << groupNs << " ns" << std::endl;
+        std::cout << "    SlotRef    : " << refNs << " ns" << std::endl;
+        std::cout << "    比率       : " << ratio << "x" << (refSum == groupSum ? "" : "（合計値不一致）") << std::endl;
+
+        slotRefs.clear();
+        ownersA.clear();
+        ownersB.clear();
+    }
+
     // --- 弱参照 Lock（WeakSignalSlotPtr vs weak_ptr）---
     {
         auto& pool = SignalSlotSystem<BenchData>::GetInstance();
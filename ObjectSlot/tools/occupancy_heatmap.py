@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+"""ExportOccupancyMap() が書き出したCSVをヒートマップとして描画する。
+
+使い方:
+    python occupancy_heatmap.py occupancy.csv              # 画面に表示
+    python occupancy_heatmap.py occupancy.csv -o out.png   # 画像に保存
+    python occupancy_heatmap.py occupancy.csv --metric age # 最古要素の経過時間を描画
+
+プールごとに1つの図を作り、横軸を書き出し時刻（スナップショット）、縦軸をページ番号として
+各ページの生存率（live / slots）または最古の生存要素の経過時間を色で表す。
+未コミットのページは灰色、スロットを含まないページは空白になる。
+
+matplotlibが無い環境では、最新のスナップショットを文字で表示する。
+"""
+
+import argparse
+import csv
+import sys
+from collections import defaultdict
+
+# 文字表示用の濃淡（生存率 0 → 1）
+SHADES = " .:-=+*#%@"
+
+
+def load(path):
+    """CSVを読み込み、プール名 → {時刻 → [行]} の辞書を返す。"""
+    pools = defaultdict(lambda: defaultdict(list))
+    with open(path, newline="") as f:
+        for row in csv.DictReader(f):
+            pools[row["pool"]][int(row["timestamp_ms"])].append(row)
+    return pools
+
+
+def cell_value(row, metric):
+    """1ページ分の値を求める（描画しないページはNone）。"""
+    slots = int(row["slots"])
+    if metric == "age":
+        age = row["oldest_age_ms"]
+        return float(age) / 1000.0 if age else None
+    if slots == 0:
+        return None
+    return int(row["live"]) / slots
+
+
+def build_grid(snapshots, metric):
+    """時刻順のスナップショットから (時刻一覧, ページ×時刻の値, コミット状態) を作る。"""
+    times = sorted(snapshots)
+    page_count = max(int(r["page"]) for rows in snapshots.values() for r in rows) + 1
+    values = [[None] * len(times) for _ in range(page_count)]
+    committed = [[False] * len(times) for _ in range(page_count)]
+    for x, t in enumerate(times):
+        for row in snapshots[t]:
+            page = int(row["page"])
+            values[page][x] = cell_value(row, metric)
+            committed[page][x] = row["committed"] == "1"
+    return times, values, committed
+
+
+def print_text(pools, metric):
+    """最新のスナップショットを1行64ページで文字表示する。"""
+    for name, snapshots in pools.items():
+        latest = snapshots[max(snapshots)]
+        live = sum(int(r["live"]) for r in latest)
+        dead = sum(int(r["dead"]) for r in latest)
+        print(f"{name}: pages={len(latest)} live={live} dead={dead}")
+        line = ""
+        for row in sorted(latest, key=lambda r: int(r["page"])):
+            value = cell_value(row, metric)
+            if row["committed"] != "1":
+                line += "_"
+            elif value is None:
+                line += " "
+            elif metric == "age":
+                line += "#"
+            else:
+                # 生存要素が1つでもあれば空白にはしない
+                shade = min(int(value * len(SHADES)), len(SHADES) - 1)
+                line += SHADES[max(shade, 1) if value > 0 else 0]
+            if len(line) == 64:
+                print("  |" + line + "|")
+                line = ""
+        if line:
+            print("  |" + line.ljust(64) + "|")
+
+
+def plot(pools, metric, output):
+    import matplotlib.pyplot as plt
+    import numpy as np
+
+    fig, axes = plt.subplots(len(pools), 1, figsize=(10, 3 * len(pools)), squeeze=False)
+    for ax, (name, snapshots) in zip(axes[:, 0], pools.items()):
+        times, values, committed = build_grid(snapshots, metric)
+        grid = np.array([[np.nan if v is None else v for v in row] for row in values])
+        mask = np.array([[0.0 if c else 1.0 for c in row] for row in committed])
+
+        start = times[0]
+        extent = [0, (times[-1] - start) / 1000.0 + 1, len(values), 0]
+        ax.imshow(np.where(mask > 0, 1.0, np.nan), aspect="auto", cmap="Greys", vmin=0, vmax=4,
+                  extent=extent, interpolation="nearest")
+        image = ax.imshow(grid, aspect="auto", cmap="viridis", extent=extent, interpolation="nearest",
+                          vmin=0.0, vmax=1.0 if metric == "live" else None)
+        ax.set_title(name)
+        ax.set_xlabel("経過時間 [s]")
+        ax.set_ylabel("ページ")
+        fig.colorbar(image, ax=ax, label="生存率" if metric == "live" else "最古要素の経過時間 [s]")
+
+    fig.tight_layout()
+    if output:
+        fig.savefig(output, dpi=150)
+    else:
+        plt.show()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("csv", help="ExportOccupancyMap() の出力")
+    parser.add_argument("-o", "--output", help="画像の保存先（省略時は画面に表示）")
+    parser.add_argument("--metric", choices=["live", "age"], default="live", help="色で表す値")
+    parser.add_argument("--text", action="store_true", help="matplotlibを使わずに文字で表示する")
+    args = parser.parse_args()
+
+    pools = load(args.csv)
+    if not pools:
+        print("占有状況の行がありません。", file=sys.stderr)
+        return 1
+
+    if not args.text:
+        try:
+            plot(pools, args.metric, args.output)
+            return 0
+        except ImportError:
+            print("matplotlibが見つからないため、文字で表示します。", file=sys.stderr)
+    print_text(pools, args.metric)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())